@@ -1,4 +1,5 @@
 #include "cache.h"
+#include "../threading/core_manager.h"
 
 #include <utility>
 
@@ -13,17 +14,23 @@
 // 4 = 4-Way Set-Associative
 // 8 = 8-Way Set-Associative
 // 0 = fully associative
+// block size B is per level and must be a power of two, so offset and index stay shifts and masks
 Cache::Cache(int t_cache_size, int t_associativity, std::string t_replacement_policy, 
-    std::string t_write_policy, Level t_cache_level, Cache* t_next_level, Memory& t_memory, CacheStats* t_stats, bool isVerbose, CoreManager* t_core_manager) 
+    std::string t_write_policy, Level t_cache_level, Cache* t_next_level, Memory& t_memory, CacheStats* t_stats, bool isVerbose, CoreManager* t_core_manager,
+    int t_block_size) 
     : m_replacement_policy(std::move(t_replacement_policy)),
+    m_replacement(parseReplacementPolicy(m_replacement_policy)),
     m_cache_size(t_cache_size),
     m_associativity(t_associativity),
+    m_block_size(validateBlockSize(t_block_size)),
+    m_words_per_block(m_block_size / sizeof(int)),
     m_num_sets(calculateNumberSets()),
-    m_offset_bits(static_cast<int>(log2(defaults::BLOCK_SIZE))),
-    m_index_bits(static_cast<int>(log2(m_num_sets))),
+    m_offset_bits(static_cast<int>(log2(m_block_size))),
+    m_index_bits(static_cast<int>(ceil(log2(m_num_sets)))),
     m_tag_bits(defaults::ADDRESS_BITS - m_index_bits - m_offset_bits),
     m_fifo_ptr(m_num_sets, 0),
     m_write_policy(std::move(t_write_policy)),
+    m_write_back(parseWritePolicy(m_write_policy)),
     m_next_level_cache(t_next_level),
     m_cache_level(t_cache_level),
     m_memory(t_memory),
@@ -31,46 +38,298 @@ Cache::Cache(int t_cache_size, int t_associativity, std::string t_replacement_po
     m_isVerbose(isVerbose),
     m_core_manager(t_core_manager)
     {
+    m_pow2_sets = (m_num_sets & (m_num_sets - 1)) == 0;
+    m_set_reciprocal = UINT64_MAX / static_cast<uint64_t>(m_num_sets);
+
+    CacheLine empty_line;
+    empty_line.m_data.assign(m_words_per_block, 0);
     if (m_associativity == 0) {
-        m_cache_sets = std::vector<std::vector<CacheLine>>(1, std::vector<CacheLine>(m_cache_size / defaults::BLOCK_SIZE));
+        m_cache_sets = std::vector<std::vector<CacheLine>>(1, std::vector<CacheLine>(m_cache_size / m_block_size, empty_line));
+    } else {
+        m_cache_sets = std::vector<std::vector<CacheLine>>(m_num_sets, std::vector<CacheLine>(m_associativity, empty_line));
+    }
+    if (m_next_level_cache != nullptr) {
+        m_next_level_cache->m_prev_level_caches.push_back(this);
+    }
+    if (m_cache_level == Level::L1) {
+        m_hit_latency = defaults::L1_HIT_LATENCY;
+    } else if (m_cache_level == Level::L2) {
+        m_hit_latency = defaults::L2_HIT_LATENCY;
     } else {
-        m_cache_sets = std::vector<std::vector<CacheLine>>(m_num_sets, std::vector<CacheLine>(m_associativity));
+        m_hit_latency = defaults::L3_HIT_LATENCY;
+    }
+}
+
+// inclusion policy describes how this level relates to the levels above it:
+// INCLUSIVE = every upper-level block is also held here, evictions back-invalidate upper levels
+// EXCLUSIVE = a block lives here or above, never both; this level is filled by upper-level victims
+// NINE      = non-inclusive non-exclusive, fills go to every level and evictions are independent
+// L1 has no upper levels, so its policy has no effect
+void Cache::setInclusionPolicy(const std::string& t_inclusion_policy) {
+    if (t_inclusion_policy != "INCLUSIVE" && t_inclusion_policy != "EXCLUSIVE" && t_inclusion_policy != "NINE") {
+        throw CacheException("Invalid inclusion policy: " + t_inclusion_policy);
+    }
+    m_inclusion_policy = t_inclusion_policy;
+    if (t_inclusion_policy == "INCLUSIVE") {
+        m_inclusion = InclusionPolicy::INCLUSIVE;
+    } else if (t_inclusion_policy == "EXCLUSIVE") {
+        m_inclusion = InclusionPolicy::EXCLUSIVE;
+    } else {
+        m_inclusion = InclusionPolicy::NINE;
+    }
+}
+
+void Cache::attachVictimCache(int t_num_entries) {
+    m_victim_cache = std::make_unique<VictimCache>(t_num_entries);
+}
+
+void Cache::attachPrefetcher(const std::string& t_type, int t_degree, int t_fill_delay) {
+    m_prefetcher = createPrefetcher(t_type, t_degree, m_block_size);
+    m_prefetch_fill_delay = t_fill_delay;
+}
+
+// a demand hit on a prefetched line makes the prefetch useful. if the fill was still in
+// flight (issued fewer than m_prefetch_fill_delay demand accesses ago) it was also late.
+// returns true when the hit should train the prefetcher (tagged prefetching)
+bool Cache::consumePrefetchedLine(CacheLine* t_line, uint64_t t_address) {
+    if (!t_line->m_prefetched) {
+        return false;
+    }
+    t_line->m_prefetched = false;
+    m_stats->prefetch_useful++;
+
+    auto inflight = m_inflight_prefetches.find(alignToBlock(t_address));
+    if (inflight != m_inflight_prefetches.end()) {
+        if (m_demand_accesses < inflight->second) {
+            m_stats->prefetch_late++;
+        }
+        m_inflight_prefetches.erase(inflight);
+    }
+    return true;
+}
+
+void Cache::triggerPrefetch(uint64_t t_address) {
+    if (m_prefetcher == nullptr) {
+        return;
+    }
+    m_prefetch_candidates.clear();
+    m_prefetcher->train(alignToBlock(t_address), m_prefetch_candidates);
+    for (uint64_t candidate : m_prefetch_candidates) {
+        prefetchBlock(candidate);
+    }
+}
+
+// fills a block without counting it as a demand access. blocks already cached,
+// buffered in the victim cache, outside of memory or in an unsampled set are dropped
+void Cache::prefetchBlock(uint64_t t_block_address) {
+    if (!m_memory.inRange(t_block_address) || !m_memory.inRange(t_block_address + m_block_size - sizeof(int))) {
+        return;
+    }
+    if (!isSampledSet(extractIndex(t_block_address))) {
+        return;
+    }
+    if (probeCacheLine(t_block_address) != nullptr) {
+        return;
+    }
+    if (m_victim_cache != nullptr && m_victim_cache->contains(t_block_address)) {
+        return;
+    }
+
+    if (m_memory.hasDram()) {
+        lookupLatencyBelow(t_block_address); // off the critical path, only the DRAM state matters
+    }
+
+    int index = extractIndex(t_block_address);
+    handleEviction(index, extractTag(t_block_address));
+    CacheLine* line = probeCacheLine(t_block_address);
+    if (line == nullptr) {
+        throw CacheException("Unexpected null cache line after eviction in prefetch.");
+    }
+    for (size_t i = 0; i < m_words_per_block; i++) {
+        line->m_data[i] = m_memory.read(t_block_address + (i * sizeof(int)));
+        m_stats->memory_accesses++;
+    }
+    line->m_prefetched = true;
+    if (m_core_manager != nullptr) {
+        line->m_mesi_state = MESI_State::SHARED;
+    }
+    m_stats->prefetches_issued++;
+
+    if (m_prefetch_fill_delay > 0) {
+        // drop stale entries so the in-flight table stays bounded
+        if (m_inflight_prefetches.size() > defaults::PREFETCH_INFLIGHT_LIMIT) {
+            for (auto it = m_inflight_prefetches.begin(); it != m_inflight_prefetches.end();) {
+                it = (it->second <= m_demand_accesses) ? m_inflight_prefetches.erase(it) : std::next(it);
+            }
+        }
+        m_inflight_prefetches[t_block_address] = m_demand_accesses + m_prefetch_fill_delay;
+    }
+
+    if (m_isVerbose) {
+        std::cout << "[PREFETCH] " << m_prefetcher->getName() << " | Address: 0x" << std::hex << t_block_address
+                  << std::dec << " | Index: " << index << std::endl;
     }
 }
 
+// probed on a miss before going to the next level. on hit the buffered block is
+// swapped back into the set and the line it displaces takes its place in the buffer
+CacheLine* Cache::refillFromVictimCache(uint64_t t_address, int t_index, uint64_t t_tag) {
+    if (m_victim_cache == nullptr) {
+        return nullptr;
+    }
+    uint64_t block_address = alignToBlock(t_address);
+    CacheLine buffered;
+    if (!m_victim_cache->extract(block_address, buffered)) {
+        m_stats->victim_misses++;
+        return nullptr;
+    }
+    m_stats->victim_hits++;
+    m_access_cycles += defaults::VICTIM_CACHE_LATENCY;
+
+    bool set_full = std::none_of(m_cache_sets[t_index].begin(), m_cache_sets[t_index].end(),
+                                 [](const CacheLine& line) { return !line.m_valid; });
+    if (set_full) {
+        m_stats->victim_swaps++;
+    }
+    handleEviction(t_index, t_tag);
+
+    CacheLine* line = probeCacheLine(t_address);
+    if (line == nullptr) {
+        throw CacheException("Unexpected null cache line after victim cache swap.");
+    }
+    std::copy(std::begin(buffered.m_data), std::end(buffered.m_data), std::begin(line->m_data));
+    line->m_dirty = buffered.m_dirty;
+
+    if (m_isVerbose) {
+        std::cout << "[VICTIM HIT] Address: 0x" << std::hex << t_address << std::dec
+                  << " | Index: " << t_index << " | Swapped: " << (set_full ? "true" : "false") << std::endl;
+    }
+    return line;
+}
+
+int Cache::validateBlockSize(int t_block_size) {
+    if (t_block_size < static_cast<int>(sizeof(int)) || (t_block_size & (t_block_size - 1)) != 0) {
+        throw CacheException("Block size must be a power of two of at least " + std::to_string(sizeof(int)) + " bytes.");
+    }
+    return t_block_size;
+}
+
+uint64_t Cache::alignToBlock(uint64_t t_address) const {
+    return t_address & ~static_cast<uint64_t>(m_block_size - 1);
+}
+
+ReplacementPolicy Cache::parseReplacementPolicy(const std::string& t_policy) {
+    if (t_policy == "LRU") return ReplacementPolicy::LRU;
+    if (t_policy == "PLRU") return ReplacementPolicy::PLRU;
+    if (t_policy == "LFU") return ReplacementPolicy::LFU;
+    if (t_policy == "FIFO") return ReplacementPolicy::FIFO;
+    throw CacheException("Invalid replacement policy: " + t_policy);
+}
+
+// true for write-back, false for write-through
+bool Cache::parseWritePolicy(const std::string& t_policy) {
+    if (t_policy != "WB" && t_policy != "WT") {
+        throw CacheException("Invalid write policy: " + t_policy);
+    }
+    return t_policy == "WB";
+}
+
+bool Cache::isExclusive() const {
+    return m_inclusion == InclusionPolicy::EXCLUSIVE && !m_prev_level_caches.empty();
+}
+
 // num sets = (total cache size / (block size * associativity)) || 1
+// any associativity and set count are allowed as long as the size divides evenly
 int Cache::calculateNumberSets() const {
+    if (m_cache_size <= 0 || m_associativity < 0) {
+        throw CacheException("Cache size must be positive and associativity non-negative.");
+    }
+    int set_bytes = (m_associativity == 0) ? m_block_size : m_block_size * m_associativity;
+    if (m_cache_size % set_bytes != 0) {
+        throw CacheException("Cache size " + std::to_string(m_cache_size) + " is not a multiple of block size * associativity ("
+                             + std::to_string(set_bytes) + ").");
+    }
     if (m_associativity == 0) {
         return 1;
     } 
-    return m_cache_size / (defaults::BLOCK_SIZE * m_associativity);
+    return m_cache_size / set_bytes;
 }
 
-int Cache::extractOffset(uint32_t t_address) const {
+int Cache::extractOffset(uint64_t t_address) const {
     return t_address & ((1 << m_offset_bits) - 1);
 }
 
-int Cache::extractIndex(uint32_t t_address) const {
-    return (t_address >> m_offset_bits) & ((1 << m_index_bits) - 1);
+// power-of-two set counts take the shift and mask path, others reduce the block number modulo the set count
+int Cache::extractIndex(uint64_t t_address) const {
+    if (m_pow2_sets) {
+        return (t_address >> m_offset_bits) & ((1 << m_index_bits) - 1);
+    }
+    uint64_t block = t_address >> m_offset_bits;
+    return static_cast<int>(block - divideBySets(block) * m_num_sets);
 }
 
-int Cache::extractTag(uint32_t t_address) const {
-    return (t_address >> (m_offset_bits + m_index_bits));
+uint64_t Cache::extractTag(uint64_t t_address) const {
+    if (m_pow2_sets) {
+        return (t_address >> (m_offset_bits + m_index_bits));
+    }
+    return divideBySets(t_address >> m_offset_bits);
+}
+
+uint64_t Cache::getBlockAddress(uint64_t t_tag, int t_index) const {
+    if (m_pow2_sets) {
+        return (t_tag << (m_index_bits + m_offset_bits)) | (static_cast<uint64_t>(t_index) << m_offset_bits);
+    }
+    return (t_tag * m_num_sets + t_index) << m_offset_bits;
+}
+
+// block / num sets without a hardware divide: the high half of block * floor((2^64 - 1) / sets)
+// undershoots the quotient by at most 2, which the remainder check corrects
+uint64_t Cache::divideBySets(uint64_t t_block) const {
+    uint64_t quotient = static_cast<uint64_t>((static_cast<unsigned __int128>(t_block) * m_set_reciprocal) >> 64);
+    uint64_t remainder = t_block - quotient * m_num_sets;
+    while (remainder >= static_cast<uint64_t>(m_num_sets)) {
+        quotient++;
+        remainder -= m_num_sets;
+    }
+    return quotient;
+}
+
+// lookup without touching replacement metadata, used for inclusion maintenance
+CacheLine* Cache::probeCacheLine(uint64_t t_address) {
+    int index = (m_associativity == 0) ? 0 : extractIndex(t_address);
+    uint64_t tag = extractTag(t_address);
+
+    for (CacheLine& line : m_cache_sets[index]) {
+        if (line.m_tag == tag && line.m_valid) {
+            if (!line.m_data_loaded) {
+                loadLineData(line, getBlockAddress(tag, index));
+            }
+            return &line;
+        }
+    }
+    return nullptr;
 }
 
-CacheLine* Cache::findCacheLine(uint32_t t_address) {
+void Cache::writeBackLine(const CacheLine& t_line, uint64_t t_block_address) {
+    if (!m_warming) {
+        m_access_cycles += memoryAccessCycles(t_block_address, true, m_writeback_latency);
+    }
+    for (size_t i = 0; i < m_words_per_block; i++) {
+        m_memory.write(t_block_address + (i * sizeof(int)), t_line.m_data[i]);
+        m_stats->memory_accesses++;
+    }
+}
+
+CacheLine* Cache::findCacheLine(uint64_t t_address) {
     int index = (m_associativity == 0) ? 0 : extractIndex(t_address);
-    int tag = extractTag(t_address);
+    uint64_t tag = extractTag(t_address);
 
     for (CacheLine& line : m_cache_sets[index]) {
         if (line.m_tag == tag && line.m_valid) {
-            if (m_replacement_policy == "LRU" && m_associativity != 0) {
-                updateLRU(index, &line);
-            } else if (m_replacement_policy == "LRU" && m_associativity == 0) {
-                updateLRU(0, &line);
-            } else if (m_replacement_policy == "LFU") {
-                line.m_lfu_counter++; 
+            if (!line.m_data_loaded) {
+                loadLineData(line, getBlockAddress(tag, index));
             }
+            touchLine(index, &line);
             return &line;
         }
     }
@@ -78,19 +337,32 @@ CacheLine* Cache::findCacheLine(uint32_t t_address) {
     return nullptr;
 }
 
+// replacement update of a lookup that found the line
+void Cache::touchLine(int t_index, CacheLine* t_line) {
+    if (m_replacement == ReplacementPolicy::LRU) {
+        updateLRU(t_index, t_line);
+    } else if (m_replacement == ReplacementPolicy::LFU) {
+        t_line->m_lfu_counter++;
+    } else if (m_replacement == ReplacementPolicy::PLRU) {
+        updatePLRU(t_index, t_line);
+    }
+}
+
 
-void Cache::forwardToNextLevel(uint32_t t_address, bool t_isWrite, int t_value) {
+void Cache::forwardToNextLevel(uint64_t t_address, bool t_isWrite, int t_value) {
     if (m_next_level_cache != nullptr) {
         if (m_isVerbose) {
             std::cout << "[FORWARD] Address: 0x" << std::hex << t_address 
                       << " | Level: " << (m_cache_level == L1 ? "L1" : "L2") 
                       << " -> Next Level" << std::dec << std::endl;
         }
+        m_next_level_cache->m_now = m_now + m_access_cycles;
         if (t_isWrite) {
             m_next_level_cache->write(t_address, t_value);
         } else {
             m_next_level_cache->read(t_address);
         }
+        m_access_cycles += m_next_level_cache->m_access_cycles;
     } else { // if there's no next level, access main memory
         if (m_isVerbose) {
             std::cout << "[MEMORY ACCESS] Address: 0x" << std::hex << t_address 
@@ -103,10 +375,11 @@ void Cache::forwardToNextLevel(uint32_t t_address, bool t_isWrite, int t_value)
             m_memory.read(t_address); // read (no actual effect since memory isn't simulated so do nothing with value)
             m_stats->memory_accesses++;
         }
+        m_access_cycles += memoryAccessCycles(t_address, t_isWrite, m_memory_latency);
     }
 }
 
-void Cache::handleEviction(int t_index, int t_tag) {
+void Cache::handleEviction(int t_index, uint64_t t_tag) {
     m_stats->evictions++;
     for (CacheLine& line : m_cache_sets[t_index]) {
         if (!line.m_valid) {  // found an invalid (empty) line
@@ -115,7 +388,13 @@ void Cache::handleEviction(int t_index, int t_tag) {
             line.m_dirty = false;
             line.m_lfu_counter = 1;
             line.m_lru_age = 1;
+            line.m_prefetched = false;
+            line.m_write_allocated = false;
+            line.m_data_loaded = true;
             std::fill(std::begin(line.m_data), std::end(line.m_data), 0);  // init new block
+            if (m_replacement == ReplacementPolicy::PLRU) {
+                updatePLRU(t_index, &line);
+            }
 
             if (m_isVerbose) {
                 std::cout << "[ALLOCATE] New Block Assigned | Index: " << t_index 
@@ -140,7 +419,13 @@ void Cache::handleEviction(int t_index, int t_tag) {
             line.m_dirty = false;
             line.m_lfu_counter = 1;
             line.m_lru_age = 1;
+            line.m_prefetched = false;
+            line.m_write_allocated = false;
+            line.m_data_loaded = true;
             std::fill(std::begin(line.m_data), std::end(line.m_data), 0);  // init new block
+            if (m_replacement == ReplacementPolicy::PLRU) {
+                updatePLRU(t_index, &line);
+            }
             return;
         }
     }
@@ -150,14 +435,172 @@ void Cache::handleEviction(int t_index, int t_tag) {
 }
 
 
-void Cache::evictCacheLine(int t_index) {
+// a line filled by functional warming fetches its block from memory, uncounted, the first time
+// its data is needed
+void Cache::loadLineData(CacheLine& t_line, uint64_t t_block_address) {
+    for (size_t i = 0; i < m_words_per_block; i++) {
+        t_line.m_data[i] = m_memory.read(t_block_address + (i * sizeof(int)));
+    }
+    t_line.m_data_loaded = true;
+}
+
+// functional warming for time-sampled runs: keeps tags, replacement order and dirty bits current
+// with no stats, timing or coherence. stores go straight to memory, which stays the authoritative
+// copy of every block warmed in; a line only reads its data when an eviction has to move it.
+// evictions take the detailed path, so inclusive levels back-invalidate and exclusive levels are
+// filled with the victims above them, but every level of the chain counts into a scratch copy of
+// its stats meanwhile. victim caches, prefetchers, MSHRs and write buffers are not warmed
+void Cache::warm(uint64_t t_address, bool t_isWrite, int t_value) {
+    if (m_sample_filter != nullptr && !m_sample_filter->isSampledSet(m_sample_filter->extractIndex(t_address))) {
+        if (t_isWrite) m_memory.write(t_address, t_value);
+        return; // as in a detailed run, the block never enters the hierarchy
+    }
+    setWarming(true);
+    try {
+        warmAccess(t_address, t_isWrite, t_value);
+    } catch (...) {
+        setWarming(false);
+        throw;
+    }
+    setWarming(false);
+}
+
+// this level and every one below it: while warming, stats go to m_warming_stats and nothing is timed
+void Cache::setWarming(bool t_warming) {
+    for (Cache* cache = this; cache != nullptr; cache = cache->m_next_level_cache) {
+        if (cache->m_warming != t_warming) {
+            cache->m_warming = t_warming;
+            std::swap(cache->m_stats, cache->m_parked_stats);
+        }
+    }
+}
+
+// one level of warm(), mirroring the fills, evictions and replacement updates of readAccess
+// and writeAccess
+void Cache::warmAccess(uint64_t t_address, bool t_isWrite, int t_value) {
+    if (m_victim_cache != nullptr) {
+        // the victim cache is not warmed, a copy parked there is retired before the store below
+        // can make its data stale
+        uint64_t block_address = alignToBlock(t_address);
+        CacheLine buffered;
+        if (m_victim_cache->extract(block_address, buffered)) {
+            retireLine(buffered, block_address);
+        }
+    }
+    if (m_cache_level == Level::L1 && t_isWrite) {
+        m_memory.write(t_address, t_value);
+    }
+    if (m_sample_ratio > 1 && !isSampledSet(extractIndex(t_address))) {
+        return; // unsampled L3 sets keep no state
+    }
+
+    int index = (m_associativity == 0) ? 0 : extractIndex(t_address);
+    uint64_t tag = extractTag(t_address);
+    CacheLine* line = nullptr;
+    for (CacheLine& candidate : m_cache_sets[index]) {
+        if (candidate.m_tag == tag && candidate.m_valid) {
+            line = &candidate;
+            break;
+        }
+    }
+    if (m_miss_classifier != nullptr) {
+        m_miss_classifier->access(t_address >> m_offset_bits, line != nullptr);
+    }
+
+    if (isExclusive()) {
+        // a read hit moves the block up and out of this level, anything else continues below
+        // without allocating; a write drops the copy here like writeExclusive
+        if (line != nullptr && !t_isWrite) {
+            touchLine(index, line);
+            touchAccessedLine(index, line);
+        }
+        if (line != nullptr) {
+            line->m_valid = false;
+            line->m_dirty = false;
+        }
+        if ((line == nullptr || t_isWrite) && m_next_level_cache != nullptr) {
+            m_next_level_cache->warmAccess(t_address, t_isWrite, t_value);
+        }
+        return;
+    }
+
+    if (line == nullptr) {
+        if (t_isWrite && m_write_around) {
+            if (m_next_level_cache != nullptr) m_next_level_cache->warmAccess(t_address, true, t_value);
+            return;
+        }
+        // same fill path as a detailed miss: write misses only read for ownership below a
+        // write-back level when the next level tracks inclusion
+        bool fill_below = !t_isWrite || (m_next_level_cache != nullptr && m_next_level_cache->m_inclusion != InclusionPolicy::NINE && m_write_back);
+        if (m_next_level_cache != nullptr && fill_below) {
+            m_next_level_cache->warmAccess(t_address, false);
+        }
+        line = &warmFill(index, tag);
+        touchLine(index, line);
+    } else {
+        touchLine(index, line);
+        touchAccessedLine(index, line);
+    }
+
+    if (!t_isWrite) {
+        return;
+    }
+    if (line->m_data_loaded) {
+        line->m_data[extractOffset(t_address) / sizeof(int)] = t_value;
+    }
+    if (m_write_back) {
+        line->m_dirty = true;
+    } else if (m_next_level_cache != nullptr) {
+        m_next_level_cache->warmAccess(t_address, true, t_value);
+    }
+}
+
+// the second replacement update a detailed hit applies once the lookup has found the line
+void Cache::touchAccessedLine(int t_index, CacheLine* t_line) {
+    if (m_replacement == ReplacementPolicy::LRU) {
+        updateLRU(t_index, t_line);
+    } else if (m_replacement == ReplacementPolicy::PLRU) {
+        updatePLRU(t_index, t_line);
+    }
+}
+
+// claims an invalid way, or evicts the policy's victim through evictCacheLine first. the new line
+// fetches its data from memory only when it is first needed
+CacheLine& Cache::warmFill(int t_index, uint64_t t_tag) {
+    std::vector<CacheLine>& set = m_cache_sets[t_index];
+    auto is_free = [](const CacheLine& line) { return !line.m_valid; };
+    auto free_line = std::find_if(set.begin(), set.end(), is_free);
+    if (free_line == set.end()) {
+        evictCacheLine(t_index);
+        free_line = std::find_if(set.begin(), set.end(), is_free);
+        if (free_line == set.end()) {
+            throw CacheException("Eviction failed: No available slots after eviction.");
+        }
+    }
+    CacheLine& line = *free_line;
+    line.m_tag = t_tag;
+    line.m_valid = true;
+    line.m_dirty = false;
+    line.m_lfu_counter = 1;
+    line.m_lru_age = 1;
+    line.m_prefetched = false;
+    line.m_write_allocated = false;
+    line.m_data_loaded = false;
+    if (m_replacement == ReplacementPolicy::PLRU) {
+        updatePLRU(t_index, &line);
+    }
+    return line;
+}
+
+// picks the line the replacement policy gives up next, FIFO advances its pointer
+int Cache::selectVictim(int t_index) {
     int evict_index = 0;
     int num_lines = (m_associativity == 0) ? m_cache_sets[0].size() : m_associativity;
 
-    if (m_replacement_policy == "FIFO") {
+    if (m_replacement == ReplacementPolicy::FIFO) {
         evict_index = m_fifo_ptr[t_index];
         m_fifo_ptr[t_index] = (m_fifo_ptr[t_index] + 1) % num_lines;
-    } else if (m_replacement_policy == "LRU") {
+    } else if (m_replacement == ReplacementPolicy::LRU) {
         int max_lru = -1;
         for (int i = 0; i < num_lines; i++) {
             CacheLine& line = (m_associativity == 0) ? m_cache_sets[0][i] : m_cache_sets[t_index][i];
@@ -166,7 +609,15 @@ void Cache::evictCacheLine(int t_index) {
                 evict_index = i; // evict index is most lru
             }
         }
-    } else if (m_replacement_policy == "LFU") {
+    } else if (m_replacement == ReplacementPolicy::PLRU) {
+        for (int i = 0; i < num_lines; i++) {
+            CacheLine& line = (m_associativity == 0) ? m_cache_sets[0][i] : m_cache_sets[t_index][i];
+            if (line.m_valid && !line.m_plru_mru) {
+                evict_index = i; // first line not touched since the last reset
+                break;
+            }
+        }
+    } else if (m_replacement == ReplacementPolicy::LFU) {
         int min_lfu = INT_MAX;
         for (int i = 0; i < num_lines; i++) {
             CacheLine& line = (m_associativity == 0) ? m_cache_sets[0][i] : m_cache_sets[t_index][i];
@@ -177,7 +628,11 @@ void Cache::evictCacheLine(int t_index) {
         }
     }
 
-    // If WB, write dirty block to memory
+    return evict_index;
+}
+
+void Cache::evictCacheLine(int t_index) {
+    int evict_index = selectVictim(t_index);
     CacheLine& evicted_line = (m_associativity == 0) ? m_cache_sets[0][evict_index] : m_cache_sets[t_index][evict_index];
 
     if (m_isVerbose) {
@@ -188,19 +643,120 @@ void Cache::evictCacheLine(int t_index) {
                   << std::endl;
     }
 
-    if (evicted_line.m_valid && evicted_line.m_dirty && m_write_policy == "WB") {
-        m_stats->dirty_evictions++;
-        uint32_t block_address = (evicted_line.m_tag << (m_index_bits + m_offset_bits)) | (t_index << m_offset_bits);
-        for (size_t i = 0; i < defaults::BLOCK_SIZE / sizeof(int); i++) {
-            m_memory.write(block_address + (i * sizeof(int)), evicted_line.m_data[i]);
-            m_stats->memory_accesses++;
-        }
-        evicted_line.m_dirty = false;
+    if (!evicted_line.m_valid) return;
+    if (m_set_profiler != nullptr && !m_warming) {
+        m_set_profiler->recordEviction(t_index);
+    }
+
+    uint64_t block_address = getBlockAddress(evicted_line.m_tag, t_index);
+    if (!evicted_line.m_data_loaded) {
+        loadLineData(evicted_line, block_address);
+    }
+    CacheLine victim = evicted_line;
+    if (victim.m_write_allocated) {
+        m_stats->write_fills_unread++;
+    }
+    if (victim.m_prefetched) {
+        m_stats->prefetch_unused++;
+        victim.m_prefetched = false;
     }
 
     // invalidate cache line
     evicted_line.m_valid = false;
     evicted_line.m_dirty = false;
+
+    if (m_inclusion == InclusionPolicy::INCLUSIVE) {
+        backInvalidate(block_address);
+    }
+
+    if (m_victim_cache != nullptr && !m_warming) {
+        // the victim buffer keeps the line as-is, dirty data is written back once it is displaced
+        std::optional<VictimEntry> displaced = m_victim_cache->insert(block_address, victim);
+        if (!displaced.has_value()) return;
+        block_address = displaced->m_block_address;
+        victim = displaced->m_line;
+    }
+
+    retireLine(victim, block_address);
+}
+
+// a line leaving this level for good: if WB, write dirty block to memory, then
+// hand it to an exclusive next level
+void Cache::retireLine(CacheLine& t_line, uint64_t t_block_address) {
+    if (t_line.m_dirty && m_write_back) {
+        m_stats->dirty_evictions++;
+        writeBackLine(t_line, t_block_address);
+        t_line.m_dirty = false;
+    }
+
+    if (m_next_level_cache != nullptr && m_next_level_cache->isExclusive()) {
+        m_next_level_cache->insertVictim(t_block_address, t_line);
+    }
+}
+
+// inclusive: a block leaving this level must leave every level above it too. an upper level
+// with smaller blocks can hold several pieces of it, each of them is invalidated
+void Cache::backInvalidate(uint64_t t_block_address) {
+    for (Cache* upper_cache : m_prev_level_caches) {
+        for (int offset = 0; offset < m_block_size; offset += upper_cache->m_block_size) {
+            uint64_t upper_block = upper_cache->alignToBlock(t_block_address + offset);
+            CacheLine* line = upper_cache->probeCacheLine(upper_block);
+            if (line != nullptr) {
+                if (m_isVerbose) {
+                    std::cout << "[BACK INVALIDATE] Address: 0x" << std::hex << upper_block << std::dec
+                              << " | Dirty: " << (line->m_dirty ? "true" : "false") << std::endl;
+                }
+                if (line->m_dirty && upper_cache->m_write_back) {
+                    upper_cache->writeBackLine(*line, upper_block);
+                }
+                line->m_valid = false;
+                line->m_dirty = false;
+                line->m_mesi_state = MESI_State::INVALID;
+                m_stats->back_invalidations++;
+            }
+            CacheLine buffered;
+            if (upper_cache->m_victim_cache != nullptr && upper_cache->m_victim_cache->extract(upper_block, buffered)) {
+                if (buffered.m_dirty && upper_cache->m_write_back) {
+                    upper_cache->writeBackLine(buffered, upper_block);
+                }
+                m_stats->back_invalidations++;
+            }
+            upper_cache->backInvalidate(upper_block);
+        }
+    }
+}
+
+// exclusive: victims of the level above are placed here instead of being dropped.
+// dirty data was already written back by the upper level, so the copy is clean
+void Cache::insertVictim(uint64_t t_block_address, const CacheLine& t_victim) {
+    int index = extractIndex(t_block_address);
+    if (!isSampledSet(index)) {
+        return; // victims were already written back above, the unsampled set keeps no state
+    }
+    CacheLine* line = probeCacheLine(t_block_address);
+    if (line == nullptr) {
+        handleEviction(index, extractTag(t_block_address));
+        line = probeCacheLine(t_block_address);
+        if (line == nullptr) {
+            throw CacheException("Unexpected null cache line after eviction in victim fill.");
+        }
+    }
+    if (t_victim.m_data.size() == line->m_data.size()) {
+        std::copy(t_victim.m_data.begin(), t_victim.m_data.end(), line->m_data.begin());
+    } else {
+        // different block sizes: the victim is clean, so memory holds the same data for the whole block
+        uint64_t block_address = alignToBlock(t_block_address);
+        for (size_t i = 0; i < m_words_per_block; i++) {
+            line->m_data[i] = m_memory.read(block_address + (i * sizeof(int)));
+        }
+    }
+    line->m_dirty = false;
+    m_stats->exclusive_fills++;
+
+    if (m_isVerbose) {
+        std::cout << "[VICTIM FILL] Address: 0x" << std::hex << t_block_address << std::dec
+                  << " | Index: " << index << std::endl;
+    }
 }
 
 void Cache::updateLRU(int t_index, CacheLine* accessedLine) {
@@ -214,8 +770,298 @@ void Cache::updateLRU(int t_index, CacheLine* accessedLine) {
     }
 }
 
+// bit-PLRU: one MRU bit per line. touching a line sets its bit, and once every valid line in
+// the set is marked the others are cleared, so the victim is always a line not touched recently
+void Cache::updatePLRU(int t_index, CacheLine* t_accessed_line) {
+    t_accessed_line->m_plru_mru = true;
+    for (const CacheLine& line : m_cache_sets[t_index]) {
+        if (line.m_valid && !line.m_plru_mru) {
+            return;
+        }
+    }
+    for (CacheLine& line : m_cache_sets[t_index]) {
+        line.m_plru_mru = (&line == t_accessed_line);
+    }
+}
+
+// public entry points time every access: each level starts at its hit latency and adds
+// whatever the access waits on below it (next level, memory, writebacks). L1 records the total
+int Cache::read(uint64_t t_address) {
+    if (m_sample_filter != nullptr && filterUnsampledRequest(t_address)) {
+        return m_memory.read(t_address);
+    }
+    if (m_sample_ratio > 1 && skipUnsampledSet(t_address)) {
+        return m_memory.read(t_address);
+    }
+    uint64_t core_cycles_before = m_total_cycles;
+    int misses_before = m_stats->l3_misses;
+    beginAccess();
+    uint64_t pending_ready = 0;
+    bool pending = m_mshrs != nullptr && m_mshrs->isPending(alignToBlock(t_address), pending_ready);
+    int value = readAccess(t_address);
+    if (m_write_buffer != nullptr && m_drain_when_idle && !m_write_buffer->isEmpty()) {
+        // loads leave the store path idle, the oldest entry drains in the background
+        drainWriteBufferEntry(*m_write_buffer->popOldest(), false);
+    }
+    completeAccess(t_address, pending, pending_ready);
+    if (m_sample_ratio > 1) {
+        recordSetSample(t_address, misses_before);
+    }
+    if (m_sample_filter != nullptr) {
+        m_sampled_cycles += m_total_cycles - core_cycles_before;
+        m_sampled_accesses++;
+    }
+    return value;
+}
 
-int Cache::read(uint32_t t_address) {
+void Cache::write(uint64_t t_address, int t_value) {
+    if (m_sample_filter != nullptr && filterUnsampledRequest(t_address)) {
+        m_memory.write(t_address, t_value); // the block never enters the hierarchy, memory keeps the data
+        return;
+    }
+    if (m_sample_ratio > 1 && skipUnsampledSet(t_address)) {
+        return; // memory already holds the value, stores below the first level are functional only
+    }
+    uint64_t core_cycles_before = m_total_cycles;
+    int misses_before = m_stats->l3_misses;
+    beginAccess();
+    uint64_t pending_ready = 0;
+    bool pending = m_mshrs != nullptr && m_mshrs->isPending(alignToBlock(t_address), pending_ready);
+    writeAccess(t_address, t_value);
+    completeAccess(t_address, pending, pending_ready);
+    if (m_sample_ratio > 1) {
+        recordSetSample(t_address, misses_before);
+    }
+    if (m_sample_filter != nullptr) {
+        m_sampled_cycles += m_total_cycles - core_cycles_before;
+        m_sampled_accesses++;
+    }
+}
+
+// set sampling simulates only every Nth set of the L3 and extrapolates its miss rate. accesses to
+// other sets leave no state or stats behind and are charged the mean latency of the sampled ones
+void Cache::setSetSampling(int t_ratio) {
+    if (m_cache_level != Level::L3) {
+        throw CacheException("Set sampling is only supported at L3.");
+    }
+    if (t_ratio < 1) {
+        throw CacheException("Set sampling ratio must be at least 1.");
+    }
+    m_sample_ratio = t_ratio;
+    m_stats->l3_sample_ratio = t_ratio;
+    m_stats->l3_total_sets = m_num_sets;
+    size_t sampled_sets = (m_num_sets + t_ratio - 1) / t_ratio;
+    m_stats->l3_sample_accesses.assign(sampled_sets, 0);
+    m_stats->l3_sample_misses.assign(sampled_sets, 0);
+}
+
+bool Cache::skipUnsampledSet(uint64_t t_address) {
+    if (isSampledSet(extractIndex(t_address))) {
+        return false;
+    }
+    m_stats->l3_skipped_accesses++;
+    m_access_cycles = (m_sampled_accesses == 0) ? m_hit_latency : m_sampled_cycles / m_sampled_accesses;
+    return true;
+}
+
+// with the filter on, requests whose last-level set is not sampled skip the whole hierarchy. when
+// every level's set count is a multiple of the ratio (and block sizes match) each upper-level set sees
+// either all of its traffic or none of it, so the sampled sets behave exactly as in a full run
+void Cache::enableSampleFilter() {
+    const Cache* llc = this;
+    while (llc->m_next_level_cache != nullptr) {
+        llc = llc->m_next_level_cache;
+    }
+    m_sample_filter = (llc == this) ? nullptr : llc;
+}
+
+bool Cache::filterUnsampledRequest(uint64_t t_address) {
+    if (m_sample_filter->isSampledSet(m_sample_filter->extractIndex(t_address))) {
+        return false;
+    }
+    m_stats->l3_filtered_requests++;
+    m_access_cycles = (m_sampled_accesses == 0) ? m_hit_latency : m_sampled_cycles / m_sampled_accesses;
+    m_total_cycles += m_access_cycles;
+    return true;
+}
+
+void Cache::recordSetSample(uint64_t t_address, int t_misses_before) {
+    size_t sample = extractIndex(t_address) / m_sample_ratio;
+    m_stats->l3_sample_accesses[sample]++;
+    m_stats->l3_sample_misses[sample] += m_stats->l3_misses - t_misses_before;
+    m_sampled_cycles += m_access_cycles;
+    m_sampled_accesses++;
+}
+
+// the shadow holds as many lines as this level simulates, so a set-sampled L3 is compared against
+// a fully associative cache of its sampled sets only
+void Cache::enableMissClassification() {
+    int num_sets = (m_associativity == 0) ? 1 : (m_num_sets + m_sample_ratio - 1) / m_sample_ratio;
+    int lines_per_set = static_cast<int>(m_cache_sets[0].size());
+    m_miss_classifier = std::make_unique<MissClassifier>(num_sets * lines_per_set);
+    m_stats->classify_misses = true;
+}
+
+// per-set heat map of demand accesses; a fully associative level is a single set
+void Cache::attachSetProfiler(int t_top_k) {
+    m_set_profiler = std::make_unique<SetProfiler>(m_num_sets, t_top_k);
+}
+
+void Cache::resetSetProfile() {
+    if (m_set_profiler != nullptr) {
+        m_set_profiler->resetCounts();
+    }
+}
+
+void Cache::profileAccess(uint64_t t_address, bool t_hit) {
+    if (m_set_profiler != nullptr) {
+        m_set_profiler->recordAccess(extractIndex(t_address), alignToBlock(t_address), t_hit);
+    }
+    if (m_miss_classifier == nullptr) {
+        return;
+    }
+    MissClass kind = m_miss_classifier->access(t_address >> m_offset_bits, t_hit);
+    if (m_cache_level == Level::L1) {
+        m_stats->l1_miss_classes.record(kind);
+    } else if (m_cache_level == Level::L2) {
+        m_stats->l2_miss_classes.record(kind);
+    } else {
+        m_stats->l3_miss_classes.record(kind);
+    }
+}
+
+// another core wrote the block: the copy here is dropped, so the next access misses instead of
+// reading stale data. a copy parked in the victim cache goes too, or a later miss would swap it back
+// in. dirty data goes back to memory first, untimed, like a snoop write-back
+CoherenceCopy Cache::invalidateForCoherence(uint64_t t_address) {
+    uint64_t block_address = alignToBlock(t_address);
+    CoherenceCopy dropped = CoherenceCopy::NONE;
+    auto drop = [&](const CacheLine& t_copy) {
+        if (t_copy.m_dirty) {
+            for (size_t i = 0; i < m_words_per_block; i++) {
+                m_memory.write(block_address + (i * sizeof(int)), t_copy.m_data[i]);
+                m_stats->memory_accesses++;
+            }
+            dropped = CoherenceCopy::DIRTY;
+        } else if (dropped == CoherenceCopy::NONE) {
+            dropped = CoherenceCopy::CLEAN;
+        }
+    };
+
+    CacheLine* line = probeCacheLine(t_address);
+    if (line != nullptr) {
+        drop(*line);
+        line->m_valid = false;
+        line->m_dirty = false;
+        line->m_mesi_state = MESI_State::INVALID;
+    }
+    CacheLine buffered;
+    if (m_victim_cache != nullptr && m_victim_cache->extract(block_address, buffered)) {
+        drop(buffered);
+    }
+    if (dropped != CoherenceCopy::NONE && m_miss_classifier != nullptr) {
+        m_miss_classifier->noteInvalidation(t_address >> m_offset_bits);
+    }
+    return dropped;
+}
+
+void Cache::beginAccess() {
+    m_access_cycles = m_hit_latency;
+    m_missed = false;
+    m_mshr_stall = 0;
+    if (m_cache_level == Level::L1) {
+        m_now = m_total_cycles; // lower levels are handed the requester's clock on forward
+    }
+    if (m_mshrs != nullptr) {
+        m_mshrs->retire(m_now);
+        m_stats->recordMshrOccupancy(m_mshrs->getOccupancy());
+    }
+}
+
+// with MSHRs a primary miss holds an entry until its fill lands and may first wait for a free one,
+// while an access to a block whose fill is still in flight merges into that entry and waits for it
+void Cache::completeAccess(uint64_t t_address, bool t_pending, uint64_t t_pending_ready) {
+    if (m_mshrs != nullptr) {
+        if (m_missed) {
+            m_mshrs->allocate(alignToBlock(t_address), m_now + m_access_cycles);
+            m_stats->mshr_allocations++;
+        } else if (t_pending && t_pending_ready > m_now) {
+            m_stats->mshr_merged++;
+            m_access_cycles = std::max(m_access_cycles, t_pending_ready - m_now);
+            if (m_isVerbose) {
+                std::cout << "[MSHR MERGE] Address: 0x" << std::hex << t_address << std::dec
+                          << " | Ready In: " << (t_pending_ready - m_now) << " cycles" << std::endl;
+            }
+        }
+    }
+    if (m_cache_level == Level::L1) {
+        // a blocking cache stalls the core for the whole access, a non-blocking one only
+        // for its hit latency and any wait for a free MSHR
+        m_total_cycles += (m_mshrs != nullptr) ? m_hit_latency + m_mshr_stall : m_access_cycles;
+        m_stats->recordAccessLatency(m_access_cycles);
+    }
+}
+
+// core cycles, including misses still outstanding when the trace ends
+uint64_t Cache::getTotalCycles() const {
+    if (m_mshrs != nullptr) {
+        return std::max(m_total_cycles, m_mshrs->getLastCompletion());
+    }
+    return m_total_cycles;
+}
+
+void Cache::attachMshrs(int t_num_entries) {
+    m_mshrs = std::make_unique<MshrFile>(t_num_entries);
+}
+
+// a miss leaving this level needs a free MSHR first, so the wait delays the request sent below
+void Cache::beginMiss(uint64_t t_address) {
+    m_missed = true;
+    if (m_mshrs == nullptr) {
+        return;
+    }
+    m_mshr_stall = m_mshrs->reserve(alignToBlock(t_address), m_now);
+    if (m_mshr_stall > 0) {
+        m_stats->mshr_full_stalls++;
+        m_stats->mshr_stall_cycles += m_mshr_stall;
+        m_access_cycles += m_mshr_stall;
+    }
+}
+
+// cost of bringing a block up from below without touching any lower level's state, used
+// when the functional model allocates on a write miss without forwarding the request
+uint64_t Cache::lookupLatencyBelow(uint64_t t_address) {
+    uint64_t cycles = 0;
+    int memory_latency = m_memory_latency;
+    for (Cache* cache = m_next_level_cache; cache != nullptr; cache = cache->m_next_level_cache) {
+        cycles += cache->m_hit_latency;
+        if (cache->probeCacheLine(t_address) != nullptr) {
+            return cycles;
+        }
+        memory_latency = cache->m_memory_latency;
+    }
+    return cycles + memoryAccessCycles(t_address, false, memory_latency);
+}
+
+// requests reaching memory are timed by the DRAM model when one is attached,
+// otherwise they cost the flat latency configured for this level
+uint64_t Cache::memoryAccessCycles(uint64_t t_address, bool t_isWrite, int t_flat_latency) {
+    if (m_memory.hasDram()) {
+        return m_memory.accessDram(alignToBlock(t_address), t_isWrite);
+    }
+    return t_flat_latency;
+}
+
+void Cache::setLatency(int t_hit_latency, int t_memory_latency, int t_writeback_latency) {
+    if (t_hit_latency < 0 || t_memory_latency < 0 || t_writeback_latency < 0) {
+        throw CacheException("Latencies must be non-negative.");
+    }
+    m_hit_latency = t_hit_latency;
+    m_memory_latency = t_memory_latency;
+    m_writeback_latency = t_writeback_latency;
+}
+
+int Cache::readAccess(uint64_t t_address) {
     if (t_address % sizeof(int) != 0) {
         if (m_isVerbose) std::cerr << "[ERROR] Unaligned cache read at address 0x" << std::hex << t_address << std::dec << "\n";
         throw CacheException("Unaligned cache read.");
@@ -231,7 +1077,8 @@ int Cache::read(uint32_t t_address) {
     }
 
     int index = extractIndex(t_address);
-     int tag = extractTag(t_address);
+     uint64_t tag = extractTag(t_address);
+    m_demand_accesses++;
 
     CacheLine* line = findCacheLine(t_address);
     if (line != nullptr) {
@@ -251,10 +1098,14 @@ int Cache::read(uint32_t t_address) {
         } else if (m_cache_level == Level::L3) {
             m_stats->l3_hits++;
         }
+        profileAccess(t_address, true);
 
-        if (m_replacement_policy == "LRU") {
+        if (m_replacement == ReplacementPolicy::LRU) {
             updateLRU((m_associativity == 0) ? 0 : index, line);
+        } else if (m_replacement == ReplacementPolicy::PLRU) {
+            updatePLRU((m_associativity == 0) ? 0 : index, line);
         }
+        line->m_write_allocated = false;
 
         if (m_core_manager != nullptr) {
             // if another core has this line in MESI_State::MODIFIED, it must downgrade it
@@ -262,6 +1113,17 @@ int Cache::read(uint32_t t_address) {
             updateMESI(t_address, MESI_State::SHARED);
         }
 
+        if (isExclusive()) {
+            // block moves up into the requesting level and leaves this one
+            if (line->m_dirty && m_write_back) {
+                writeBackLine(*line, getBlockAddress(line->m_tag, (m_associativity == 0) ? 0 : index));
+            }
+            line->m_valid = false;
+            line->m_dirty = false;
+        } else if (consumePrefetchedLine(line, t_address)) {
+            triggerPrefetch(t_address);
+        }
+
         return retrieved_value;
 
     }
@@ -277,9 +1139,30 @@ int Cache::read(uint32_t t_address) {
     } else if (m_cache_level == Level::L3) {
         m_stats->l3_misses++;
     }
+    profileAccess(t_address, false);
+    if (m_prefetcher != nullptr) {
+        m_stats->prefetch_level_misses++;
+    }
 
+    CacheLine* victim_line = refillFromVictimCache(t_address, index, tag);
+    if (victim_line != nullptr) {
+        if (m_core_manager != nullptr) {
+            updateMESI(t_address, MESI_State::EXCLUSIVE);
+        }
+        int victim_value = victim_line->m_data[extractOffset(t_address) / sizeof(int)];
+        triggerPrefetch(t_address);
+        return victim_value;
+    }
+
+    beginMiss(t_address);
+    drainPendingStores(t_address);
     forwardToNextLevel(t_address, false);
 
+    if (isExclusive()) {
+        // exclusive levels only hold upper-level victims, the block bypasses this level
+        return m_memory.read(t_address);
+    }
+
      // cache miss: fetch from next level (load block into cache)
      handleEviction(index, tag); // evict if needed
  
@@ -290,8 +1173,8 @@ int Cache::read(uint32_t t_address) {
     }
  
      // fetch full block from memory
-     uint32_t block_start_address = t_address & ~(defaults::BLOCK_SIZE - 1);
-     for (long unsigned int i = 0; i < defaults::BLOCK_SIZE / sizeof(int); i++) {
+     uint64_t block_start_address = alignToBlock(t_address);
+     for (long unsigned int i = 0; i < m_words_per_block; i++) {
          line->m_data[i] = m_memory.read(block_start_address + (i * sizeof(int)));
          m_stats->memory_accesses++;
      }
@@ -303,7 +1186,7 @@ int Cache::read(uint32_t t_address) {
      if (m_isVerbose) {
         std::cout << "[FETCH] Block loaded from memory into cache. Address Range: 0x" 
                   << std::hex << block_start_address << " - 0x" 
-                  << (block_start_address + defaults::BLOCK_SIZE) << std::dec << std::endl;
+                  << (block_start_address + m_block_size) << std::dec << std::endl;
     }
 
     int value_offset = extractOffset(t_address) / sizeof(int);
@@ -313,10 +1196,11 @@ int Cache::read(uint32_t t_address) {
         std::cout << "[READ COMPLETE] Retrieved Value: " << retrieved_value 
                   << " from Address: 0x" << std::hex << t_address << std::dec << std::endl;
     }
+    triggerPrefetch(t_address);
     return retrieved_value;
 }
 
-void Cache::write(uint32_t t_address, int t_value) {
+void Cache::writeAccess(uint64_t t_address, int t_value) {
     if (t_address % sizeof(int) != 0) {
         if (m_isVerbose) std::cerr << "[ERROR] Unaligned cache write at address 0x" << std::hex << t_address << std::dec << "\n";
         throw CacheException("Unaligned cache write");
@@ -332,7 +1216,13 @@ void Cache::write(uint32_t t_address, int t_value) {
     }
 
     int index = extractIndex(t_address);
-    int tag = extractTag(t_address);
+    uint64_t tag = extractTag(t_address);
+
+    if (isExclusive()) {
+        writeExclusive(t_address, t_value);
+        return;
+    }
+    m_demand_accesses++;
 
     CacheLine* line = findCacheLine(t_address);
     if (line != nullptr) { // cache hit: update the value
@@ -350,6 +1240,8 @@ void Cache::write(uint32_t t_address, int t_value) {
         } else if (m_cache_level == Level::L3) {
             m_stats->l3_hits++;
         }
+        profileAccess(t_address, true);
+        bool prefetch_trigger = consumePrefetchedLine(line, t_address);
 
         if (m_core_manager != nullptr) {
             // if another core has this in MESI_State::MODIFIED, force WB
@@ -359,23 +1251,22 @@ void Cache::write(uint32_t t_address, int t_value) {
 
         updateMESI(t_address, MESI_State::MODIFIED);
 
-        if (m_write_policy == "WB") {
+        if (m_write_back) {
             line->m_dirty = true; // mark as modified for Write-Back
             if (m_isVerbose) {
                 std::cout << "[WRITE BACK] Marking line as dirty\n";
             }
         } else { // WT
-            m_memory.write(t_address, t_value); // WT writes immediately to memory
-            m_stats->memory_accesses++;
-            forwardToNextLevel(t_address, true, t_value);
-            if (m_isVerbose) {
-                std::cout << "[WRITE THROUGH] Value written to memory at address: 0x" 
-                          << std::hex << t_address << std::dec << std::endl;
-            }
+            writeThrough(t_address, t_value);
         }
 
-        if (m_replacement_policy == "LRU") {
+        if (m_replacement == ReplacementPolicy::LRU) {
             updateLRU((m_associativity == 0) ? 0 : index, line);
+        } else if (m_replacement == ReplacementPolicy::PLRU) {
+            updatePLRU((m_associativity == 0) ? 0 : index, line);
+        }
+        if (prefetch_trigger) {
+            triggerPrefetch(t_address);
         }
         return;
     }
@@ -391,67 +1282,231 @@ void Cache::write(uint32_t t_address, int t_value) {
     } else if (m_cache_level == Level::L3) {
         m_stats->l3_misses++;
     }
+    profileAccess(t_address, false);
+    if (m_prefetcher != nullptr) {
+        m_stats->prefetch_level_misses++;
+    }
 
-    // cache miss: get block from memory
-    handleEviction(index, tag);
-    line = findCacheLine(t_address);
-
-    if (line == nullptr) {
-        // should never happen, but safety check
-        if (m_isVerbose) std::cerr << "[ERROR] Unexpected null cache line after eviction." << std::endl;
-        throw CacheException("Unexpected null cache line after eviction in cache write.");
+    line = refillFromVictimCache(t_address, index, tag);
+    if (line == nullptr && m_write_around) {
+        writeAround(t_address, t_value);
+        triggerPrefetch(t_address);
+        return;
     }
+    if (line == nullptr) {
+        beginMiss(t_address);
+        // inclusive and exclusive levels below must see the fill (read for ownership)
+        if (m_next_level_cache != nullptr && m_next_level_cache->m_inclusion != InclusionPolicy::NINE && m_write_back) {
+            forwardToNextLevel(t_address, false);
+        } else {
+            m_access_cycles += lookupLatencyBelow(t_address);
+        }
 
-    // fetch block from memory and store in cache
-    uint32_t block_start_address = t_address & ~(defaults::BLOCK_SIZE - 1);
-    for (long unsigned int i = 0; i < defaults::BLOCK_SIZE / sizeof(int); i++) {
-        line->m_data[i] = m_memory.read(block_start_address + (i * sizeof(int))); // read block size from memory
-        m_stats->memory_accesses++;
+        // cache miss: get block from memory
+        handleEviction(index, tag);
+        line = findCacheLine(t_address);
+
+        if (line == nullptr) {
+            // should never happen, but safety check
+            if (m_isVerbose) std::cerr << "[ERROR] Unexpected null cache line after eviction." << std::endl;
+            throw CacheException("Unexpected null cache line after eviction in cache write.");
+        }
+
+        // fetch block from memory and store in cache
+        uint64_t block_start_address = alignToBlock(t_address);
+        for (long unsigned int i = 0; i < m_words_per_block; i++) {
+            line->m_data[i] = m_memory.read(block_start_address + (i * sizeof(int))); // read block size from memory
+            m_stats->memory_accesses++;
+        }
+        line->m_write_allocated = true;
+        m_stats->write_allocate_fills++;
+
+        if (m_isVerbose) {
+            std::cout << "[FETCH] Block loaded from memory into cache. Address Range: 0x" 
+                      << std::hex << block_start_address << " - 0x" 
+                      << (block_start_address + m_block_size) << std::dec << std::endl;
+        }
     }
 
     // writing new value to line
     int word_offset = extractOffset(t_address) / sizeof(int);
     line->m_data[word_offset] = t_value;
 
-    if (m_isVerbose) {
-        std::cout << "[FETCH] Block loaded from memory into cache. Address Range: 0x" 
-                  << std::hex << block_start_address << " - 0x" 
-                  << (block_start_address + defaults::BLOCK_SIZE) << std::dec << std::endl;
-    }
-
     if (m_core_manager != nullptr) {
         m_core_manager->invalidateOtherCaches(t_address, this);
     }
 
     updateMESI(t_address, MESI_State::MODIFIED);
 
-    if (m_write_policy == "WB") {
+    if (m_write_back) {
         line->m_dirty = true;
         if (m_isVerbose) {
             std::cout << "[WRITE BACK] Marking line as dirty\n";
         }
     } else { // WT
+        writeThrough(t_address, t_value);
+    }
+    triggerPrefetch(t_address);
+}
+
+// no-write-allocate: the store bypasses this level and continues to the next one (write-around),
+// so no line is displaced and no block is fetched. memory is updated immediately since fills read it
+void Cache::writeAround(uint64_t t_address, int t_value) {
+    m_stats->write_arounds++;
+    m_stats->write_fill_words_saved += m_words_per_block;
+    if (m_core_manager != nullptr) {
+        m_core_manager->invalidateOtherCaches(t_address, this);
+    }
+    if (m_isVerbose) {
+        std::cout << "[WRITE AROUND] Address: 0x" << std::hex << t_address << std::dec
+                  << " | No line allocated" << std::endl;
+    }
+    if (!m_write_back) {
+        writeThrough(t_address, t_value);
+    } else {
         m_memory.write(t_address, t_value);
+        forwardToNextLevel(t_address, true, t_value);
+    }
+}
+
+// "WA" allocates a line on a write miss, "NWA" writes around this level
+void Cache::setWriteAllocate(const std::string& t_write_allocate) {
+    if (t_write_allocate != "WA" && t_write_allocate != "NWA") {
+        throw CacheException("Invalid write allocate policy: " + t_write_allocate);
+    }
+    m_write_allocate = t_write_allocate;
+    m_write_around = (t_write_allocate == "NWA");
+}
+
+// without a write buffer every store goes to memory and the next level at once. with one, the store
+// is parked in the buffer and only drains to the next level later, coalesced with stores to the same
+// block. memory is updated immediately either way since fills read it, but the traffic is only
+// counted when the store actually leaves the buffer
+void Cache::writeThrough(uint64_t t_address, int t_value) {
+    if (m_write_buffer == nullptr) {
+        m_memory.write(t_address, t_value); // WT writes immediately to memory
         m_stats->memory_accesses++;
         forwardToNextLevel(t_address, true, t_value);
         if (m_isVerbose) {
             std::cout << "[WRITE THROUGH] Value written to memory at address: 0x" 
                       << std::hex << t_address << std::dec << std::endl;
         }
+        return;
+    }
+
+    m_memory.write(t_address, t_value);
+    m_stats->write_buffer_stores++;
+    if (m_write_buffer->coalesce(t_address, t_value)) {
+        m_stats->write_buffer_coalesced++;
+        if (m_isVerbose) {
+            std::cout << "[WRITE BUFFER] Coalesced store to 0x" << std::hex << t_address << std::dec << std::endl;
+        }
+        return;
+    }
+    if (m_write_buffer->isFull()) {
+        // the store waits for the oldest entry to drain
+        m_stats->write_buffer_full_stalls++;
+        drainWriteBufferEntry(*m_write_buffer->popOldest(), true);
+    }
+    m_write_buffer->insert(t_address, t_value);
+    if (m_isVerbose) {
+        std::cout << "[WRITE BUFFER] Buffered store to 0x" << std::hex << t_address << std::dec
+                  << " | Entries: " << m_write_buffer->getSize() << "/" << m_write_buffer->getNumEntries() << std::endl;
+    }
+}
+
+// sends the written words of one entry to the next level as a single transaction: when timed,
+// the access in progress pays for the first word only, otherwise the drain is off its critical path
+void Cache::drainWriteBufferEntry(const WriteBufferEntry& t_entry, bool t_timed) {
+    uint64_t cycles_before = m_access_cycles;
+    uint64_t transaction_cycles = 0;
+    bool first = true;
+    for (size_t word = 0; word < m_words_per_block; word++) {
+        if ((t_entry.m_word_mask & (1ULL << word)) == 0) continue;
+        forwardToNextLevel(t_entry.m_block_address + (word * sizeof(int)), true, t_entry.m_data[word]);
+        if (first) {
+            transaction_cycles = m_access_cycles - cycles_before;
+            first = false;
+        }
+        m_access_cycles = cycles_before;
+        m_stats->write_buffer_drained_words++;
+    }
+    m_stats->write_buffer_drains++;
+    if (t_timed) {
+        m_access_cycles += transaction_cycles;
+    }
+    if (m_isVerbose) {
+        std::cout << "[WRITE BUFFER DRAIN] Block: 0x" << std::hex << t_entry.m_block_address << std::dec
+                  << " | Timed: " << (t_timed ? "true" : "false") << std::endl;
+    }
+}
+
+// a read miss must not overtake buffered stores to its block on the way down
+void Cache::drainPendingStores(uint64_t t_address) {
+    WriteBufferEntry entry;
+    if (m_write_buffer != nullptr && m_write_buffer->extract(alignToBlock(t_address), entry)) {
+        drainWriteBufferEntry(entry, true);
+    }
+}
+
+void Cache::attachWriteBuffer(int t_num_entries, const std::string& t_drain_policy) {
+    if (t_drain_policy != "FULL" && t_drain_policy != "IDLE") {
+        throw CacheException("Invalid write buffer drain policy: " + t_drain_policy);
+    }
+    m_write_buffer = std::make_unique<WriteBuffer>(t_num_entries, m_block_size);
+    m_drain_when_idle = (t_drain_policy == "IDLE");
+}
+
+// writes reaching an exclusive level come from a write-through level above, which owns the block;
+// any copy here is dropped and the write continues down without allocating
+void Cache::writeExclusive(uint64_t t_address, int t_value) {
+    CacheLine* line = probeCacheLine(t_address);
+    if (line != nullptr) {
+        if (m_cache_level == Level::L2) {
+            m_stats->l2_hits++;
+        } else if (m_cache_level == Level::L3) {
+            m_stats->l3_hits++;
+        }
+        profileAccess(t_address, true);
+        line->m_valid = false;
+        line->m_dirty = false;
+    } else {
+        if (m_cache_level == Level::L2) {
+            m_stats->l2_misses++;
+        } else if (m_cache_level == Level::L3) {
+            m_stats->l3_misses++;
+        }
+        profileAccess(t_address, false);
+    }
+
+    if (m_isVerbose) {
+        std::cout << "[EXCLUSIVE WRITE] Address: 0x" << std::hex << t_address << std::dec
+                  << " | Bypassing Level: " << (m_cache_level == L2 ? "L2" : "L3") << std::endl;
+    }
+    forwardToNextLevel(t_address, true, t_value);
+}
+
+void Cache::drainWriteBuffer() {
+    while (m_write_buffer != nullptr && !m_write_buffer->isEmpty()) {
+        drainWriteBufferEntry(*m_write_buffer->popOldest(), false);
     }
 }
 
 void Cache::flushCache() {
+    drainWriteBuffer();
     for (size_t set_index = 0; set_index < m_cache_sets.size(); set_index++) {
         for (CacheLine& line : m_cache_sets[set_index]) {
             if (line.m_valid && line.m_dirty) {
-                uint32_t block_address = (line.m_tag << (m_index_bits + m_offset_bits)) | (set_index << m_offset_bits);
+                uint64_t block_address = getBlockAddress(line.m_tag, set_index);
+                if (!line.m_data_loaded) {
+                    loadLineData(line, block_address);
+                }
                 if (m_isVerbose) {
                     std::cout << "[FLUSH] Writing dirty cache line to memory | Address Range: 0x"
                               << std::hex << block_address << " - 0x" 
-                              << (block_address + defaults::BLOCK_SIZE) << std::dec << std::endl;
+                              << (block_address + m_block_size) << std::dec << std::endl;
                 }
-                for (size_t i = 0; i < defaults::BLOCK_SIZE / sizeof(int); i++) {
+                for (size_t i = 0; i < m_words_per_block; i++) {
                     m_memory.write(block_address + (i * sizeof(int)), line.m_data[i]);
                     m_stats->memory_accesses++;
                 }
@@ -459,9 +1514,107 @@ void Cache::flushCache() {
             }
         }
     }
+    if (m_victim_cache != nullptr) {
+        m_victim_cache->forEachDirtyEntry([this](uint64_t block_address, CacheLine& line) {
+            writeBackLine(line, block_address);
+            line.m_dirty = false;
+        });
+    }
+}
+
+// checkpoint state of one level: geometry first so a restore into a different configuration is
+// refused, then every set's lines, the FIFO pointers and the victim cache, oldest entry first.
+// write buffers must be drained beforehand; MSHRs, in-flight prefetches and prefetcher training
+// are timing state and start empty after a restore
+void Cache::saveState(std::ostream& t_out) const {
+    if (m_write_buffer != nullptr && !m_write_buffer->isEmpty()) {
+        throw CacheException("Write buffer must be drained before saving a checkpoint.");
+    }
+    binary_io::write<int32_t>(t_out, m_block_size);
+    binary_io::write<uint32_t>(t_out, static_cast<uint32_t>(m_cache_sets.size()));
+    binary_io::write<uint32_t>(t_out, static_cast<uint32_t>(m_cache_sets[0].size()));
+    for (size_t set_index = 0; set_index < m_cache_sets.size(); set_index++) {
+        binary_io::write<int32_t>(t_out, m_fifo_ptr[set_index]);
+        for (const CacheLine& line : m_cache_sets[set_index]) {
+            saveLine(t_out, line);
+        }
+    }
+    binary_io::write<uint32_t>(t_out, m_victim_cache == nullptr ? 0 : m_victim_cache->getSize());
+    if (m_victim_cache != nullptr) {
+        m_victim_cache->forEachEntry([&t_out](const VictimEntry& entry) {
+            binary_io::write<uint64_t>(t_out, entry.m_block_address);
+            saveLine(t_out, entry.m_line);
+        });
+    }
+}
+
+// victims that do not fit this level's victim cache (or a level without one) are written back
+void Cache::restoreState(std::istream& t_in) {
+    int block_size = binary_io::read<int32_t>(t_in);
+    uint32_t num_sets = binary_io::read<uint32_t>(t_in);
+    uint32_t lines_per_set = binary_io::read<uint32_t>(t_in);
+    if (block_size != m_block_size || num_sets != m_cache_sets.size() || lines_per_set != m_cache_sets[0].size()) {
+        throw CacheException("Checkpoint geometry does not match the configured cache.");
+    }
+    for (size_t set_index = 0; set_index < m_cache_sets.size(); set_index++) {
+        m_fifo_ptr[set_index] = binary_io::read<int32_t>(t_in);
+        for (CacheLine& line : m_cache_sets[set_index]) {
+            restoreLine(t_in, line);
+        }
+    }
+    uint32_t victims = binary_io::read<uint32_t>(t_in);
+    for (uint32_t i = 0; i < victims; i++) {
+        VictimEntry entry{binary_io::read<uint64_t>(t_in), CacheLine()};
+        entry.m_line.m_data.assign(m_words_per_block, 0);
+        restoreLine(t_in, entry.m_line);
+        std::optional<VictimEntry> displaced = entry;
+        if (m_victim_cache != nullptr) {
+            displaced = m_victim_cache->insert(entry.m_block_address, entry.m_line);
+        }
+        if (displaced.has_value() && displaced->m_line.m_dirty) {
+            writeBackLine(displaced->m_line, displaced->m_block_address);
+        }
+    }
+    m_access_cycles = 0;
+}
+
+// flags byte, then tag and replacement metadata for valid lines and data for loaded ones
+void Cache::saveLine(std::ostream& t_out, const CacheLine& t_line) {
+    uint8_t flags = (t_line.m_valid ? 1 : 0) | (t_line.m_dirty ? 2 : 0) | (t_line.m_prefetched ? 4 : 0)
+        | (t_line.m_write_allocated ? 8 : 0) | (t_line.m_data_loaded ? 16 : 0) | (t_line.m_plru_mru ? 32 : 0);
+    binary_io::write<uint8_t>(t_out, flags);
+    if (!t_line.m_valid) return;
+    binary_io::write<uint64_t>(t_out, t_line.m_tag);
+    binary_io::write<int32_t>(t_out, t_line.m_lru_age);
+    binary_io::write<int32_t>(t_out, t_line.m_lfu_counter);
+    binary_io::write<uint8_t>(t_out, static_cast<uint8_t>(t_line.m_mesi_state));
+    if (t_line.m_data_loaded) {
+        binary_io::writeWords(t_out, t_line.m_data);
+    }
+}
+
+void Cache::restoreLine(std::istream& t_in, CacheLine& t_line) {
+    uint8_t flags = binary_io::read<uint8_t>(t_in);
+    t_line.m_valid = flags & 1;
+    t_line.m_dirty = flags & 2;
+    t_line.m_prefetched = flags & 4;
+    t_line.m_write_allocated = flags & 8;
+    t_line.m_data_loaded = flags & 16;
+    t_line.m_plru_mru = flags & 32;
+    if (!t_line.m_valid) {
+        t_line.m_data_loaded = true;
+        return;
+    }
+    t_line.m_tag = binary_io::read<uint64_t>(t_in);
+    t_line.m_lru_age = binary_io::read<int32_t>(t_in);
+    t_line.m_lfu_counter = binary_io::read<int32_t>(t_in);
+    t_line.m_mesi_state = static_cast<MESI_State>(binary_io::read<uint8_t>(t_in));
+    if (t_line.m_data_loaded) {
+        binary_io::readWords(t_in, t_line.m_data);
+    }
 }
 
-void Cache::updateMESI(uint32_t t_address, MESI_State new_state) {
+void Cache::updateMESI(uint64_t t_address, MESI_State new_state) {
     std::lock_guard<std::mutex> lock(cache_mutex);
 
     CacheLine* line = findCacheLine(t_address);
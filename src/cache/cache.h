@@ -5,10 +5,20 @@
 #include <cmath>
 #include <climits>
 #include <deque>
+#include <memory>
+#include <mutex>
+#include <iostream>
 #include "../memory/memory.h"
 #include "../exception/cache_exception.h"
 #include "mesi.h"
-#include "../threading/core_manager.h"
+#include "cache_line.h"
+#include "victim_cache.h"
+#include "prefetcher.h"
+#include "mshr.h"
+#include "write_buffer.h"
+#include "miss_classifier.h"
+#include "set_profiler.h"
+#include "../io/binary_io.h"
 
 // forward declaring
 class CoreManager;
@@ -19,26 +29,40 @@ enum Level {
     L3
 };
 
-namespace defaults
-{
-    static constexpr int BLOCK_SIZE = 64;
-    static const int ADDRESS_BITS = sizeof(uint32_t) * 8;
-}
-
-struct CacheLine {
-    int m_tag;
-    int m_data[defaults::BLOCK_SIZE / sizeof(int)];
-    bool m_valid = false;
-    bool m_dirty = false;
-    int m_lru_age = 0;
-    int m_lfu_counter = 0;
-    MESI_State m_mesi_state = MESI_State::INVALID;
-
-    CacheLine() = default;
-
-    CacheLine(int tag) : m_tag(tag), m_valid(true), m_dirty(false), m_mesi_state(MESI_State::INVALID) {
-        std::fill(std::begin(m_data), std::end(m_data), 0);
+// policy strings parsed once, so the access path branches on these instead of comparing strings
+enum class ReplacementPolicy { LRU, PLRU, LFU, FIFO };
+enum class InclusionPolicy { INCLUSIVE, EXCLUSIVE, NINE };
+
+// what a coherence invalidation dropped: nothing, clean copies only, or dirty data it wrote back
+enum class CoherenceCopy { NONE, CLEAN, DIRTY };
+
+// one detailed measurement unit of a time-sampled run
+struct SampleUnit {
+    uint64_t operations = 0;
+    uint64_t cycles = 0;
+    uint64_t l1_misses = 0;
+    uint64_t l2_misses = 0;
+    uint64_t l3_misses = 0;
+};
+
+// demand misses of one level split by cause
+struct MissBreakdown {
+    uint64_t compulsory = 0;
+    uint64_t capacity = 0;
+    uint64_t conflict = 0;
+    uint64_t coherence = 0;
+
+    void record(MissClass t_kind) {
+        switch (t_kind) {
+            case MissClass::COMPULSORY: compulsory++; break;
+            case MissClass::CAPACITY: capacity++; break;
+            case MissClass::CONFLICT: conflict++; break;
+            case MissClass::COHERENCE: coherence++; break;
+            case MissClass::HIT: break;
+        }
     }
+
+    uint64_t total() const { return compulsory + capacity + conflict + coherence; }
 };
 
 struct CacheStats {
@@ -54,10 +78,182 @@ struct CacheStats {
     int dirty_evictions = 0;
     int memory_accesses = 0;
 
+    int back_invalidations = 0;
+    int exclusive_fills = 0;
+
+    uint64_t coherence_invalidations = 0; // copies dropped in other cores' L1s by a write
+    uint64_t coherence_downgrades = 0; // MODIFIED copies in other L1s turned SHARED by a read
+    uint64_t coherence_writebacks = 0; // the invalidated copies that were MODIFIED or dirty and written back first
+
+    int victim_hits = 0;
+    int victim_misses = 0;
+    int victim_swaps = 0;
+
+    int prefetches_issued = 0;
+    int prefetch_useful = 0;
+    int prefetch_late = 0;
+    int prefetch_unused = 0;
+    int prefetch_level_misses = 0; // demand misses at levels with a prefetcher
+
+    // fraction of issued prefetches later hit by a demand access
+    double prefetchAccuracy() const {
+        return prefetches_issued == 0 ? 0.0 : 100.0 * prefetch_useful / prefetches_issued;
+    }
+
+    // fraction of would-be misses removed by prefetching
+    double prefetchCoverage() const {
+        int total = prefetch_useful + prefetch_level_misses;
+        return total == 0 ? 0.0 : 100.0 * prefetch_useful / total;
+    }
+
+    static constexpr int LATENCY_BUCKETS = 16; // bucket i = [2^i, 2^(i+1)) cycles, last bucket open ended
+    uint64_t total_cycles = 0;
+    uint64_t latency_histogram[LATENCY_BUCKETS] = {};
+    std::vector<uint64_t> core_cycles; // simulated cycles per core, filled in when the run ends
+
+    int write_allocate_fills = 0; // lines allocated by write misses
+    int write_fills_unread = 0; // of those, evicted before any read touched them
+    int write_arounds = 0; // write misses sent to the next level without allocating
+    uint64_t write_fill_words_saved = 0; // block words no-write-allocate did not fetch
+
+    int write_buffer_stores = 0;
+    int write_buffer_coalesced = 0; // stores merged into an already buffered block
+    int write_buffer_drains = 0;
+    int write_buffer_drained_words = 0;
+    int write_buffer_full_stalls = 0;
+
+    int mshr_allocations = 0;
+    int mshr_merged = 0; // accesses to a block whose fill was still outstanding
+    int mshr_full_stalls = 0;
+    uint64_t mshr_stall_cycles = 0;
+    uint64_t mshr_occupancy_sum = 0; // busy entries seen by each access to a non-blocking level
+    uint64_t mshr_occupancy_samples = 0;
+    int mshr_peak_occupancy = 0;
+
+    int l3_sample_ratio = 1; // set sampling: only every Nth L3 set is simulated
+    int l3_total_sets = 0;
+    uint64_t l3_skipped_accesses = 0; // L3 accesses to sets outside the sample
+    uint64_t l3_filtered_requests = 0; // requests to those sets dropped before L1
+    std::vector<uint64_t> l3_sample_accesses; // per sampled set, in sample order
+    std::vector<uint64_t> l3_sample_misses;
+
+    int time_sample_period = 0; // time sampling: one detailed unit per period of requests, 0 = off
+    uint64_t warmed_requests = 0; // requests handled by functional warming between units
+    std::vector<SampleUnit> sample_units;
+
+    uint64_t warmup_requests = 0; // requests simulated before the counters were reset
+
+    bool classify_misses = false;
+    MissBreakdown l1_miss_classes, l2_miss_classes, l3_miss_classes;
+
     CacheStats() = default;
 
+    // drops everything counted so far, keeping the sampling configuration and sample layout
+    void resetCounters() {
+        CacheStats fresh;
+        fresh.l3_sample_ratio = l3_sample_ratio;
+        fresh.l3_total_sets = l3_total_sets;
+        fresh.l3_sample_accesses.assign(l3_sample_accesses.size(), 0);
+        fresh.l3_sample_misses.assign(l3_sample_misses.size(), 0);
+        fresh.time_sample_period = time_sample_period;
+        fresh.warmup_requests = warmup_requests;
+        fresh.classify_misses = classify_misses;
+        *this = std::move(fresh);
+    }
+
+    void recordMshrOccupancy(int t_occupancy) {
+        mshr_occupancy_sum += t_occupancy;
+        mshr_occupancy_samples++;
+        mshr_peak_occupancy = std::max(mshr_peak_occupancy, t_occupancy);
+    }
+
+    double averageMshrOccupancy() const {
+        return mshr_occupancy_samples == 0 ? 0.0 : static_cast<double>(mshr_occupancy_sum) / mshr_occupancy_samples;
+    }
+
+    // ratio estimate over the sampled sets: total misses / total accesses
+    double sampledL3MissRate() const {
+        uint64_t accesses = 0, misses = 0;
+        for (size_t i = 0; i < l3_sample_accesses.size(); i++) {
+            accesses += l3_sample_accesses[i];
+            misses += l3_sample_misses[i];
+        }
+        return accesses == 0 ? 0.0 : 100.0 * misses / accesses;
+    }
+    // 95% confidence half-width of the sampled miss rate, treating each sampled set as one cluster
+    // and applying the finite population correction for the sets that were not sampled
+    double sampledL3MissRateError() const {
+        size_t n = l3_sample_accesses.size();
+        if (n < 2 || l3_total_sets == 0) return 0.0;
+        double rate = sampledL3MissRate() / 100.0;
+        double accesses = 0.0, residuals = 0.0;
+        for (size_t i = 0; i < n; i++) {
+            accesses += l3_sample_accesses[i];
+            double residual = l3_sample_misses[i] - rate * l3_sample_accesses[i];
+            residuals += residual * residual;
+        }
+        if (accesses == 0.0) return 0.0;
+        double mean_accesses = accesses / n;
+        double correction = 1.0 - static_cast<double>(n) / l3_total_sets;
+        double variance = correction * (residuals / (n - 1)) / (n * mean_accesses * mean_accesses);
+        return 100.0 * 1.96 * std::sqrt(variance);
+    }
+    // sampled sets stand in for the whole cache, scaled by the fraction of sets simulated
+    uint64_t extrapolatedL3Misses() const {
+        if (l3_sample_accesses.empty()) return l3_misses;
+        return static_cast<uint64_t>(static_cast<double>(l3_misses) * l3_total_sets / l3_sample_accesses.size());
+    }
+    // mean of a per-access rate over the sampled units and its 95% confidence half-width,
+    // units are equally sized so each counts once
+    template <typename Metric>
+    std::pair<double, double> sampledRate(Metric t_metric) const {
+        size_t n = 0;
+        double sum = 0.0, sum_sq = 0.0;
+        for (const SampleUnit& unit : sample_units) {
+            if (unit.operations == 0) continue;
+            double rate = static_cast<double>(t_metric(unit)) / unit.operations;
+            sum += rate;
+            sum_sq += rate * rate;
+            n++;
+        }
+        if (n == 0) return {0.0, 0.0};
+        double mean = sum / n;
+        double variance = (n > 1) ? std::max(0.0, (sum_sq - n * mean * mean) / (n - 1)) : 0.0;
+        return {mean, 1.96 * std::sqrt(variance / n)};
+    }
+    void recordAccessLatency(uint64_t t_cycles) {
+        total_cycles += t_cycles;
+        int bucket = 0;
+        while (bucket < LATENCY_BUCKETS - 1 && (t_cycles >> (bucket + 1)) != 0) {
+            bucket++;
+        }
+        latency_histogram[bucket]++;
+    }
+
+    // every request taken from the trace, measured, warming the caches or filtered before L3
+    uint64_t simulatedRequests() const {
+        return static_cast<uint64_t>(total_operations) + warmup_requests + warmed_requests + l3_filtered_requests;
+    }
+
+    // average memory access time in cycles over all demand accesses
+    double averageMemoryAccessTime() const {
+        return total_operations == 0 ? 0.0 : static_cast<double>(total_cycles) / total_operations;
+    }
+
+    static void printMissBreakdown(const std::string& t_label, const MissBreakdown& t_classes) {
+        uint64_t total = t_classes.total();
+        auto share = [total](uint64_t t_count) { return total == 0 ? 0.0 : 100.0 * t_count / total; };
+        std::cout << t_label << " Miss Classes: compulsory " << t_classes.compulsory << " (" << share(t_classes.compulsory)
+                  << "%), capacity " << t_classes.capacity << " (" << share(t_classes.capacity)
+                  << "%), conflict " << t_classes.conflict << " (" << share(t_classes.conflict)
+                  << "%), coherence " << t_classes.coherence << " (" << share(t_classes.coherence) << "%)\n";
+    }
+
     void printSummary() const {
         std::cout << "\n===== Cache Simulation Summary =====\n";
+        if (warmup_requests > 0) {
+            std::cout << "Warm-up Requests (excluded): " << warmup_requests << "\n";
+        }
         std::cout << "Total Operations: " << total_operations << "\n";
         std::cout << "Read Operations: " << read_operations << "\n";
         std::cout << "Write Operations: " << write_operations << "\n";
@@ -69,9 +265,72 @@ struct CacheStats {
         std::cout << "L3 Hits: " << l3_hits << "\n";
         std::cout << "L3 Misses: " << l3_misses << "\n";
 
+        if (classify_misses) {
+            printMissBreakdown("L1", l1_miss_classes);
+            printMissBreakdown("L2", l2_miss_classes);
+            printMissBreakdown("L3", l3_miss_classes);
+        }
+
         std::cout << "Evictions: " << evictions << "\n";
         std::cout << "Dirty Evictions: " << dirty_evictions << "\n";
         std::cout << "Memory Accesses: " << memory_accesses << "\n";
+        std::cout << "Back Invalidations: " << back_invalidations << "\n";
+        std::cout << "Exclusive Victim Fills: " << exclusive_fills << "\n";
+        std::cout << "Coherence Invalidations: " << coherence_invalidations << " (" << coherence_downgrades << " downgrades, "
+                  << coherence_writebacks << " written back)\n";
+        std::cout << "Victim Cache Hits: " << victim_hits << "\n";
+        std::cout << "Victim Cache Misses: " << victim_misses << "\n";
+        std::cout << "Victim Cache Swaps: " << victim_swaps << "\n";
+        std::cout << "Prefetches Issued: " << prefetches_issued << "\n";
+        std::cout << "Prefetches Useful: " << prefetch_useful << " (accuracy " << prefetchAccuracy() << "%, coverage " << prefetchCoverage() << "%)\n";
+        std::cout << "Prefetches Late: " << prefetch_late << "\n";
+        std::cout << "Prefetches Unused: " << prefetch_unused << "\n";
+        std::cout << "Write Allocate Fills: " << write_allocate_fills << " (" << write_fills_unread << " evicted unread)\n";
+        std::cout << "Write Arounds: " << write_arounds << " (" << write_fill_words_saved << " fill words saved)\n";
+        std::cout << "Write Buffer Stores: " << write_buffer_stores << " (" << write_buffer_coalesced << " coalesced)\n";
+        std::cout << "Write Buffer Drains: " << write_buffer_drains << " (" << write_buffer_drained_words << " words)\n";
+        std::cout << "Write Buffer Full Stalls: " << write_buffer_full_stalls << "\n";
+        std::cout << "MSHR Allocations: " << mshr_allocations << "\n";
+        std::cout << "MSHR Merged Misses: " << mshr_merged << "\n";
+        std::cout << "MSHR Full Stalls: " << mshr_full_stalls << " (" << mshr_stall_cycles << " cycles)\n";
+        std::cout << "MSHR Occupancy: average " << averageMshrOccupancy() << ", peak " << mshr_peak_occupancy << "\n";
+        if (l3_sample_ratio > 1) {
+            uint64_t sampled = l3_hits + l3_misses;
+            std::cout << "L3 Set Sampling: " << l3_sample_accesses.size() << " of " << l3_total_sets << " sets (1/" << l3_sample_ratio
+                      << "), " << sampled << " accesses simulated, " << l3_skipped_accesses << " skipped at L3, "
+                      << l3_filtered_requests << " requests filtered before L1\n";
+            std::cout << "L3 Sampled Miss Rate: " << sampledL3MissRate() << "% +/- " << sampledL3MissRateError() << "% (95% CI)\n";
+            std::cout << "L3 Extrapolated Misses: " << extrapolatedL3Misses() << "\n";
+        }
+        if (time_sample_period > 0) {
+            auto cycles = sampledRate([](const SampleUnit& unit) { return unit.cycles; });
+            auto l1 = sampledRate([](const SampleUnit& unit) { return unit.l1_misses; });
+            auto l2 = sampledRate([](const SampleUnit& unit) { return unit.l2_misses; });
+            auto l3 = sampledRate([](const SampleUnit& unit) { return unit.l3_misses; });
+            uint64_t requests = total_operations + warmed_requests;
+            std::cout << "Time Sampling: " << sample_units.size() << " detailed units, one per " << time_sample_period
+                      << " requests, " << warmed_requests << " requests functionally warmed\n";
+            std::cout << "Sampled Cycles Per Access: " << cycles.first << " +/- " << cycles.second << " (95% CI)\n";
+            std::cout << "Sampled L1/L2/L3 Misses Per 1000 Accesses: " << 1000 * l1.first << " +/- " << 1000 * l1.second
+                      << ", " << 1000 * l2.first << " +/- " << 1000 * l2.second << ", " << 1000 * l3.first << " +/- " << 1000 * l3.second << "\n";
+            std::cout << "Extrapolated Cycles: " << static_cast<uint64_t>(cycles.first * requests) << "\n";
+        }
+        std::cout << "Simulated Cycles: " << total_cycles << "\n";
+        std::cout << "AMAT: " << averageMemoryAccessTime() << " cycles\n";
+        for (size_t core = 0; core < core_cycles.size(); core++) {
+            std::cout << "Core " << core << " Cycles: " << core_cycles[core] << "\n";
+        }
+        std::cout << "Access Latency Histogram (cycles):\n";
+        for (int bucket = 0; bucket < LATENCY_BUCKETS; bucket++) {
+            if (latency_histogram[bucket] == 0) continue;
+            std::cout << "  [" << (1ULL << bucket) << ", ";
+            if (bucket == LATENCY_BUCKETS - 1) {
+                std::cout << "inf";
+            } else {
+                std::cout << (1ULL << (bucket + 1));
+            }
+            std::cout << "): " << latency_histogram[bucket] << "\n";
+        }
         std::cout << "====================================\n";
     }
 };
@@ -80,44 +339,155 @@ class Cache {
 
 public:
     Cache(int t_cache_size, int t_associativity, std::string t_replacement_policy, std::string t_write_policy, Level t_cache_level, 
-        Cache* t_next_level, Memory& t_memory, CacheStats* t_stats, bool isVerbose = false, CoreManager* t_core_manager = nullptr);
-    int read(uint32_t t_address);
-    void write(uint32_t t_address, int t_value);
-    CacheLine* findCacheLine(uint32_t t_address);
-    void updateMESI(uint32_t t_address, MESI_State new_state);
+        Cache* t_next_level, Memory& t_memory, CacheStats* t_stats, bool isVerbose = false, CoreManager* t_core_manager = nullptr,
+        int t_block_size = defaults::BLOCK_SIZE);
+    int read(uint64_t t_address);
+    void write(uint64_t t_address, int t_value);
+    CacheLine* findCacheLine(uint64_t t_address);
+    void updateMESI(uint64_t t_address, MESI_State new_state);
     void flushCache();
+    void drainWriteBuffer();
+    void saveState(std::ostream& t_out) const;
+    void restoreState(std::istream& t_in);
+    void setInclusionPolicy(const std::string& t_inclusion_policy);
+    void attachVictimCache(int t_num_entries);
+    void attachPrefetcher(const std::string& t_type, int t_degree, int t_fill_delay = defaults::PREFETCH_FILL_DELAY);
+    void setLatency(int t_hit_latency, int t_memory_latency, int t_writeback_latency);
+    void attachMshrs(int t_num_entries);
+    void setWriteAllocate(const std::string& t_write_allocate);
+    void attachWriteBuffer(int t_num_entries, const std::string& t_drain_policy = "FULL");
+    void setSetSampling(int t_ratio);
+    void enableSampleFilter();
+    void warm(uint64_t t_address, bool t_isWrite, int t_value = 0);
+    void enableMissClassification();
+    CoherenceCopy invalidateForCoherence(uint64_t t_address);
+    void attachSetProfiler(int t_top_k);
+    void resetSetProfile();
 
     // public getters for testing
     int getOffsetBits() const { return m_offset_bits; }
+    int getBlockSize() const { return m_block_size; }
     int getIndexBits() const { return m_index_bits; }
     int getTagBits() const { return m_tag_bits; }
     int getNumSets() const { return m_num_sets; }
-    std::string getReplacementPolicy() const {return m_replacement_policy; } 
+    const std::string& getReplacementPolicy() const {return m_replacement_policy; } 
+    const std::string& getWritePolicy() const { return m_write_policy; }
+    const std::string& getInclusionPolicy() const { return m_inclusion_policy; }
+    const std::string& getWriteAllocate() const { return m_write_allocate; }
+    const VictimCache* getVictimCache() const { return m_victim_cache.get(); }
+    const Prefetcher* getPrefetcher() const { return m_prefetcher.get(); }
+    uint64_t getLastAccessCycles() const { return m_access_cycles; }
+    uint64_t getTotalCycles() const;
+    const MshrFile* getMshrs() const { return m_mshrs.get(); }
+    const WriteBuffer* getWriteBuffer() const { return m_write_buffer.get(); }
+    int getSampleRatio() const { return m_sample_ratio; }
+    const MissClassifier* getMissClassifier() const { return m_miss_classifier.get(); }
+    const SetProfiler* getSetProfiler() const { return m_set_profiler.get(); }
 
 private:
+    static int validateBlockSize(int t_block_size);
+    static ReplacementPolicy parseReplacementPolicy(const std::string& t_policy);
+    static bool parseWritePolicy(const std::string& t_policy);
+    static void saveLine(std::ostream& t_out, const CacheLine& t_line);
+    static void restoreLine(std::istream& t_in, CacheLine& t_line);
     int calculateNumberSets() const;
-    int extractTag(uint32_t t_address) const;
-    int extractIndex(uint32_t t_address) const;
-    int extractOffset(uint32_t t_address) const;
+    uint64_t alignToBlock(uint64_t t_address) const;
+    uint64_t extractTag(uint64_t t_address) const;
+    int extractIndex(uint64_t t_address) const;
+    int extractOffset(uint64_t t_address) const;
     void updateLRU(int t_index, CacheLine* accessedLine);    
+    void updatePLRU(int t_index, CacheLine* t_accessed_line);
+    int selectVictim(int t_index);
     void evictCacheLine(int t_index);
-    void handleEviction(int t_index, int t_tag);
-    void forwardToNextLevel(uint32_t t_address, bool t_isWrite, int t_value = 0);
+    void setWarming(bool t_warming);
+    void warmAccess(uint64_t t_address, bool t_isWrite, int t_value = 0);
+    CacheLine& warmFill(int t_index, uint64_t t_tag);
+    void touchLine(int t_index, CacheLine* t_line);
+    void touchAccessedLine(int t_index, CacheLine* t_line);
+    void loadLineData(CacheLine& t_line, uint64_t t_block_address);
+    void handleEviction(int t_index, uint64_t t_tag);
+    void forwardToNextLevel(uint64_t t_address, bool t_isWrite, int t_value = 0);
+    int readAccess(uint64_t t_address);
+    void writeAccess(uint64_t t_address, int t_value);
+    void beginAccess();
+    void completeAccess(uint64_t t_address, bool t_pending, uint64_t t_pending_ready);
+    void beginMiss(uint64_t t_address);
+    void writeThrough(uint64_t t_address, int t_value);
+    bool isSampledSet(int t_index) const { return t_index % m_sample_ratio == 0; }
+    bool skipUnsampledSet(uint64_t t_address);
+    bool filterUnsampledRequest(uint64_t t_address);
+    void recordSetSample(uint64_t t_address, int t_misses_before);
+    void writeAround(uint64_t t_address, int t_value);
+    void drainWriteBufferEntry(const WriteBufferEntry& t_entry, bool t_timed);
+    void drainPendingStores(uint64_t t_address);
+    uint64_t lookupLatencyBelow(uint64_t t_address);
+    uint64_t memoryAccessCycles(uint64_t t_address, bool t_isWrite, int t_flat_latency);
+    CacheLine* probeCacheLine(uint64_t t_address);
+    uint64_t getBlockAddress(uint64_t t_tag, int t_index) const;
+    uint64_t divideBySets(uint64_t t_block) const;
+    void writeBackLine(const CacheLine& t_line, uint64_t t_block_address);
+    bool isExclusive() const;
+    void backInvalidate(uint64_t t_block_address);
+    void insertVictim(uint64_t t_block_address, const CacheLine& t_victim);
+    void writeExclusive(uint64_t t_address, int t_value);
+    void retireLine(CacheLine& t_line, uint64_t t_block_address);
+    CacheLine* refillFromVictimCache(uint64_t t_address, int t_index, uint64_t t_tag);
+    bool consumePrefetchedLine(CacheLine* t_line, uint64_t t_address);
+    void triggerPrefetch(uint64_t t_address);
+    void prefetchBlock(uint64_t t_block_address);
+    void profileAccess(uint64_t t_address, bool t_hit);
 
     std::string m_replacement_policy;
+    ReplacementPolicy m_replacement; // m_replacement_policy parsed
     int m_cache_size;
     int m_associativity;
+    int m_block_size; // bytes, power of two
+    size_t m_words_per_block;
     int m_num_sets;
     int m_offset_bits;
-    int m_index_bits;
+    int m_index_bits; // rounded up when the set count is not a power of two
     int m_tag_bits;
+    bool m_pow2_sets;
+    uint64_t m_set_reciprocal; // floor((2^64 - 1) / m_num_sets) for the modulo path
     std::vector<int> m_fifo_ptr;
     std::string m_write_policy; // "WB" or "WT"
+    bool m_write_back; // m_write_policy == "WB"
+    std::string m_write_allocate = "WA"; // "WA" allocates on a write miss, "NWA" writes around
+    bool m_write_around = false; // m_write_allocate == "NWA"
     std::vector<std::vector<CacheLine>> m_cache_sets;
     Cache* m_next_level_cache; // pointer to next cache line L1->L2->L3
+    std::vector<Cache*> m_prev_level_caches; // caches this level serves (L2 -> its L1s)
+    std::string m_inclusion_policy = "NINE"; // relation to the levels above: "INCLUSIVE", "EXCLUSIVE" or "NINE"
+    InclusionPolicy m_inclusion = InclusionPolicy::NINE; // m_inclusion_policy parsed
+    std::unique_ptr<VictimCache> m_victim_cache; // optional, nullptr when disabled
+    std::unique_ptr<Prefetcher> m_prefetcher; // optional, nullptr when disabled
+    std::vector<uint64_t> m_prefetch_candidates; // reused between triggers
+    std::unordered_map<uint64_t, uint64_t> m_inflight_prefetches; // block -> demand access count when the fill lands
+    int m_prefetch_fill_delay = defaults::PREFETCH_FILL_DELAY;
+    uint64_t m_demand_accesses = 0;
+    int m_hit_latency;
+    int m_memory_latency = defaults::MEMORY_LATENCY;
+    int m_writeback_latency = defaults::WRITEBACK_LATENCY;
+    uint64_t m_access_cycles = 0; // cycles spent by the access in progress (or the last one)
+    uint64_t m_total_cycles = 0;
+    std::unique_ptr<MshrFile> m_mshrs; // optional, nullptr keeps the level blocking
+    uint64_t m_now = 0; // requester's cycle when the access in progress was issued
+    bool m_missed = false; // access in progress went below this level
+    uint64_t m_mshr_stall = 0; // cycles the access in progress waited for a free MSHR
+    std::unique_ptr<WriteBuffer> m_write_buffer; // optional, only used by write-through levels
+    bool m_drain_when_idle = false; // drain policy "IDLE" also drains on loads, "FULL" only when out of entries
+    int m_sample_ratio = 1; // L3 set sampling, 1 = every set is simulated
+    uint64_t m_sampled_cycles = 0; // latency of sampled accesses, charged on average to skipped ones
+    uint64_t m_sampled_accesses = 0;
+    const Cache* m_sample_filter = nullptr; // L1 only: the sampled last level deciding which requests enter
+    std::unique_ptr<MissClassifier> m_miss_classifier; // optional, nullptr when misses are not classified
+    std::unique_ptr<SetProfiler> m_set_profiler; // optional, nullptr when no heat map is taken
     Level m_cache_level;
     Memory& m_memory;
     CacheStats* m_stats;
+    bool m_warming = false; // inside warm(): evictions run as usual but are neither counted nor timed
+    CacheStats m_warming_stats; // scratch counters while warming, never reported
+    CacheStats* m_parked_stats = &m_warming_stats; // whichever of the two is not m_stats
     bool m_isVerbose;
     CoreManager* m_core_manager;
     std::mutex cache_mutex;
@@ -1,5 +1,7 @@
 #include "cache_config.h"
 
+#include <cctype>
+
 CacheConfig getCacheSizes(const std::string& size) {
     if (size == "small") {
         return {16 * 1024, 128 * 1024, 512 * 1024};  // L1 = 16KB, L2 = 128KB, L3 = 512KB
@@ -8,4 +10,29 @@ CacheConfig getCacheSizes(const std::string& size) {
     } else {
         return {512 * 1024, 2 * 1024 * 1024, 8 * 1024 * 1024}; // L1 = 512KB, L2 = 2MB, L3 = 8MB
     }
+}
+
+// explicit level size: plain bytes or a KB / MB suffix, e.g. "49152", "48KB", "30MB".
+// returns -1 when the string is not a valid size (at most 1GB)
+int parseCacheSize(const std::string& size) {
+    size_t digits = 0;
+    while (digits < size.size() && std::isdigit(static_cast<unsigned char>(size[digits]))) {
+        digits++;
+    }
+    if (digits == 0 || digits > 7) {
+        return -1;
+    }
+    long long bytes = std::stoll(size.substr(0, digits));
+    std::string unit = size.substr(digits);
+    if (unit == "KB") {
+        bytes *= 1024;
+    } else if (unit == "MB") {
+        bytes *= 1024 * 1024;
+    } else if (!unit.empty()) {
+        return -1;
+    }
+    if (bytes <= 0 || bytes > 1024LL * 1024 * 1024) {
+        return -1;
+    }
+    return static_cast<int>(bytes);
 }
\ No newline at end of file
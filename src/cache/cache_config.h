@@ -8,4 +8,5 @@ struct CacheConfig {
     int l3_size;
 };
 
-CacheConfig getCacheSizes(const std::string& t_size);
\ No newline at end of file
+CacheConfig getCacheSizes(const std::string& t_size);
+int parseCacheSize(const std::string& t_size);
\ No newline at end of file
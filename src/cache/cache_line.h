@@ -0,0 +1,86 @@
+#pragma once
+#include <cstdint>
+#include <cstddef>
+#include <algorithm>
+#include <iterator>
+#include <memory>
+#include "mesi.h"
+
+namespace defaults
+{
+    static constexpr int BLOCK_SIZE = 64;
+    static const int ADDRESS_BITS = sizeof(uint64_t) * 8;
+    static constexpr int PREFETCH_FILL_DELAY = 4; // demand accesses before a prefetched block counts as arrived
+    static constexpr size_t PREFETCH_INFLIGHT_LIMIT = 1024;
+
+    // latencies in simulated cycles
+    static constexpr int L1_HIT_LATENCY = 4;
+    static constexpr int L2_HIT_LATENCY = 12;
+    static constexpr int L3_HIT_LATENCY = 40;
+    static constexpr int MEMORY_LATENCY = 200;
+    static constexpr int WRITEBACK_LATENCY = 200; // blocking writeback, the evicting access waits for memory
+    static constexpr int VICTIM_CACHE_LATENCY = 1; // extra cycles on top of the L1 hit latency
+}
+
+// the words of one line. blocks up to the default size are stored inside the line, so the usual
+// geometry costs no allocation and no pointer chase per access; larger blocks live on the heap
+class LineData {
+
+public:
+    static constexpr size_t INLINE_WORDS = defaults::BLOCK_SIZE / sizeof(int);
+
+    explicit LineData(size_t t_words = INLINE_WORDS) { assign(t_words, 0); }
+    LineData(const LineData& t_other) { *this = t_other; }
+    LineData& operator=(const LineData& t_other) {
+        if (this != &t_other) {
+            resize(t_other.m_size);
+            std::copy(t_other.begin(), t_other.end(), begin());
+        }
+        return *this;
+    }
+
+    void assign(size_t t_words, int t_value) {
+        resize(t_words);
+        std::fill(begin(), end(), t_value);
+    }
+
+    size_t size() const { return m_size; }
+    int* data() { return m_heap != nullptr ? m_heap.get() : m_inline; }
+    const int* data() const { return m_heap != nullptr ? m_heap.get() : m_inline; }
+    int& operator[](size_t t_word) { return data()[t_word]; }
+    int operator[](size_t t_word) const { return data()[t_word]; }
+    int* begin() { return data(); }
+    int* end() { return data() + m_size; }
+    const int* begin() const { return data(); }
+    const int* end() const { return data() + m_size; }
+
+private:
+    void resize(size_t t_words) {
+        if (t_words == m_size) return;
+        m_heap.reset(t_words > INLINE_WORDS ? new int[t_words] : nullptr);
+        m_size = t_words;
+    }
+
+    int m_inline[INLINE_WORDS];
+    std::unique_ptr<int[]> m_heap; // only for blocks above INLINE_WORDS
+    size_t m_size = 0;
+};
+
+struct CacheLine {
+    uint64_t m_tag;
+    LineData m_data; // sized to the owning level's block
+    bool m_valid = false;
+    bool m_dirty = false;
+    bool m_prefetched = false; // filled by a prefetch and not yet touched by a demand access
+    bool m_write_allocated = false; // filled by a write miss and not read since
+    bool m_data_loaded = true; // false after a functional-warming fill, memory holds the block until it is needed
+    int m_lru_age = 0;
+    int m_lfu_counter = 0;
+    bool m_plru_mru = false; // PLRU: touched since the set last had all its MRU bits set
+    MESI_State m_mesi_state = MESI_State::INVALID;
+
+    CacheLine() = default;
+
+    CacheLine(uint64_t tag, size_t t_words = defaults::BLOCK_SIZE / sizeof(int))
+        : m_tag(tag), m_data(t_words), m_valid(true), m_dirty(false), m_mesi_state(MESI_State::INVALID) {}
+};
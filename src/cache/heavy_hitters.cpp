@@ -0,0 +1,74 @@
+#include "heavy_hitters.h"
+#include <algorithm>
+
+HeavyHitters::HeavyHitters(int t_capacity) : m_capacity(t_capacity) {
+    if (t_capacity <= 0) {
+        throw CacheException("Heavy hitters need at least one counter.");
+    }
+    m_heap.reserve(t_capacity);
+    m_position.reserve(t_capacity);
+}
+
+void HeavyHitters::add(uint64_t t_key) {
+    auto it = m_position.find(t_key);
+    if (it != m_position.end()) {
+        m_heap[it->second].m_count++;
+        siftDown(it->second);
+        return;
+    }
+    if (m_heap.size() < static_cast<size_t>(m_capacity)) {
+        m_position.emplace(t_key, m_heap.size());
+        m_heap.push_back({t_key, 1, 0});
+        siftUp(m_heap.size() - 1);
+        return;
+    }
+    Counter& root = m_heap[0];
+    m_position.erase(root.m_key);
+    root.m_error = root.m_count;
+    root.m_count++;
+    root.m_key = t_key;
+    m_position.emplace(t_key, 0);
+    siftDown(0);
+}
+
+void HeavyHitters::siftUp(size_t t_pos) {
+    while (t_pos > 0 && m_heap[(t_pos - 1) / 2].m_count > m_heap[t_pos].m_count) {
+        swapCounters(t_pos, (t_pos - 1) / 2);
+        t_pos = (t_pos - 1) / 2;
+    }
+}
+
+void HeavyHitters::siftDown(size_t t_pos) {
+    while (true) {
+        size_t smallest = t_pos;
+        size_t left = 2 * t_pos + 1;
+        size_t right = left + 1;
+        if (left < m_heap.size() && m_heap[left].m_count < m_heap[smallest].m_count) smallest = left;
+        if (right < m_heap.size() && m_heap[right].m_count < m_heap[smallest].m_count) smallest = right;
+        if (smallest == t_pos) return;
+        swapCounters(t_pos, smallest);
+        t_pos = smallest;
+    }
+}
+
+void HeavyHitters::swapCounters(size_t t_a, size_t t_b) {
+    std::swap(m_heap[t_a], m_heap[t_b]);
+    m_position[m_heap[t_a].m_key] = t_a;
+    m_position[m_heap[t_b].m_key] = t_b;
+}
+
+std::vector<HeavyHitters::Counter> HeavyHitters::top(int t_k) const {
+    std::vector<Counter> counters = m_heap;
+    std::sort(counters.begin(), counters.end(), [](const Counter& a, const Counter& b) {
+        return a.m_count != b.m_count ? a.m_count > b.m_count : a.m_key < b.m_key;
+    });
+    if (counters.size() > static_cast<size_t>(t_k)) {
+        counters.resize(t_k);
+    }
+    return counters;
+}
+
+void HeavyHitters::clear() {
+    m_heap.clear();
+    m_position.clear();
+}
@@ -0,0 +1,37 @@
+#pragma once
+#include <unordered_map>
+#include <vector>
+#include <cstdint>
+#include "../exception/cache_exception.h"
+
+// Space-Saving top-K over a stream of keys with a fixed number of counters. a key that is not
+// monitored takes over the smallest counter and inherits its count as the error bound, so every
+// reported count overestimates the true one by at most m_error and any key seen more than
+// stream / capacity times is guaranteed to be monitored. counters form a min-heap indexed by a
+// hash map, so an update costs O(log capacity)
+class HeavyHitters {
+
+public:
+    struct Counter {
+        uint64_t m_key;
+        uint64_t m_count; // upper bound on the key's occurrences
+        uint64_t m_error; // the count may exceed the true one by at most this much
+    };
+
+    explicit HeavyHitters(int t_capacity);
+
+    void add(uint64_t t_key);
+    std::vector<Counter> top(int t_k) const; // highest counts first
+    void clear();
+
+    int getCapacity() const { return m_capacity; }
+
+private:
+    void siftUp(size_t t_pos);
+    void siftDown(size_t t_pos);
+    void swapCounters(size_t t_a, size_t t_b);
+
+    int m_capacity;
+    std::vector<Counter> m_heap; // min-heap on m_count, the root is the next counter to take over
+    std::unordered_map<uint64_t, size_t> m_position; // key -> heap slot
+};
@@ -0,0 +1,75 @@
+#include "miss_classifier.h"
+
+MissClassifier::MissClassifier(int t_num_lines) {
+    if (t_num_lines <= 0) {
+        throw CacheException("Miss classifier needs at least one line.");
+    }
+    m_nodes.resize(t_num_lines);
+    m_shadow.reserve(t_num_lines);
+}
+
+// a miss is charged to coherence first, then to the first touch, then to the shadow's verdict
+MissClass MissClassifier::access(uint64_t t_block, bool t_hit) {
+    bool invalidated = !m_invalidated.empty() && m_invalidated.erase(t_block) != 0;
+    bool first = firstTouch(t_block);
+    bool shadow_hit = shadowAccess(t_block);
+    if (t_hit) return MissClass::HIT;
+    if (invalidated) return MissClass::COHERENCE;
+    if (first) return MissClass::COMPULSORY;
+    return shadow_hit ? MissClass::CONFLICT : MissClass::CAPACITY;
+}
+
+void MissClassifier::noteInvalidation(uint64_t t_block) {
+    m_invalidated.insert(t_block);
+}
+
+bool MissClassifier::firstTouch(uint64_t t_block) {
+    std::vector<uint64_t>& page = m_seen_pages[t_block >> PAGE_BITS];
+    if (page.empty()) {
+        page.assign((1 << PAGE_BITS) / 64, 0);
+    }
+    uint64_t bit = t_block & ((1 << PAGE_BITS) - 1);
+    uint64_t mask = 1ULL << (bit % 64);
+    bool first = (page[bit / 64] & mask) == 0;
+    page[bit / 64] |= mask;
+    return first;
+}
+
+// moves the block to the front of the shadow, evicting the LRU block when every node is in use
+bool MissClassifier::shadowAccess(uint64_t t_block) {
+    auto it = m_shadow.find(t_block);
+    if (it != m_shadow.end()) {
+        if (it->second != m_head) {
+            unlink(it->second);
+            pushFront(it->second);
+        }
+        return true;
+    }
+    uint32_t node;
+    if (m_used < m_nodes.size()) {
+        node = m_used++;
+    } else {
+        node = m_tail;
+        unlink(node);
+        m_shadow.erase(m_nodes[node].m_block);
+    }
+    m_nodes[node].m_block = t_block;
+    pushFront(node);
+    m_shadow.emplace(t_block, node);
+    return false;
+}
+
+void MissClassifier::unlink(uint32_t t_node) {
+    ShadowNode& node = m_nodes[t_node];
+    if (node.m_prev != NONE) m_nodes[node.m_prev].m_next = node.m_next; else m_head = node.m_next;
+    if (node.m_next != NONE) m_nodes[node.m_next].m_prev = node.m_prev; else m_tail = node.m_prev;
+}
+
+void MissClassifier::pushFront(uint32_t t_node) {
+    ShadowNode& node = m_nodes[t_node];
+    node.m_prev = NONE;
+    node.m_next = m_head;
+    if (m_head != NONE) m_nodes[m_head].m_prev = t_node;
+    m_head = t_node;
+    if (m_tail == NONE) m_tail = t_node;
+}
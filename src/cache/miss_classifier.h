@@ -0,0 +1,52 @@
+#pragma once
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include <cstdint>
+#include "../exception/cache_exception.h"
+
+enum class MissClass {
+    HIT,
+    COMPULSORY, // first access to the block at this level
+    CAPACITY,   // a fully associative LRU cache of the same size would miss too
+    CONFLICT,   // the fully associative shadow still holds the block, the set mapping lost it
+    COHERENCE   // another core's write invalidated this level's copy
+};
+
+// classifies the demand misses of one cache level (3C plus coherence). a paged bitmap marks the
+// blocks seen so far and a fully associative LRU shadow with the level's line count tells capacity
+// from conflict; the shadow is an index-linked list over a fixed node pool plus a hash map, so
+// every access is O(1) however large the level is
+class MissClassifier {
+
+public:
+    explicit MissClassifier(int t_num_lines);
+
+    MissClass access(uint64_t t_block, bool t_hit); // every demand access of the level, in order
+    void noteInvalidation(uint64_t t_block);
+
+    int getNumLines() const { return static_cast<int>(m_nodes.size()); }
+
+private:
+    static constexpr int PAGE_BITS = 12; // blocks per bitmap page = 2^12
+    static constexpr uint32_t NONE = UINT32_MAX;
+
+    struct ShadowNode {
+        uint64_t m_block;
+        uint32_t m_prev;
+        uint32_t m_next;
+    };
+
+    bool firstTouch(uint64_t t_block);
+    bool shadowAccess(uint64_t t_block);
+    void unlink(uint32_t t_node);
+    void pushFront(uint32_t t_node);
+
+    std::unordered_map<uint64_t, std::vector<uint64_t>> m_seen_pages; // page -> bitmap of its blocks
+    std::vector<ShadowNode> m_nodes;
+    std::unordered_map<uint64_t, uint32_t> m_shadow; // block -> node
+    uint32_t m_used = 0;
+    uint32_t m_head = NONE; // most recently used
+    uint32_t m_tail = NONE;
+    std::unordered_set<uint64_t> m_invalidated; // blocks dropped by coherence, not re-fetched yet
+};
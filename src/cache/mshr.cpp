@@ -0,0 +1,51 @@
+#include "mshr.h"
+
+#include <algorithm>
+#include <iterator>
+
+MshrFile::MshrFile(int t_num_entries) : m_num_entries(t_num_entries) {
+    if (m_num_entries <= 0) {
+        throw CacheException("MSHR file must have at least one entry.");
+    }
+    m_entries.reserve(m_num_entries);
+}
+
+// frees every entry whose fill has completed by t_now
+void MshrFile::retire(uint64_t t_now) {
+    for (auto it = m_entries.begin(); it != m_entries.end();) {
+        it = (it->second <= t_now) ? m_entries.erase(it) : std::next(it);
+    }
+}
+
+bool MshrFile::isPending(uint64_t t_block_address, uint64_t& t_ready_cycle) const {
+    auto it = m_entries.find(t_block_address);
+    if (it == m_entries.end()) {
+        return false;
+    }
+    t_ready_cycle = it->second;
+    return true;
+}
+
+// claims an entry for a primary miss issued at t_now. when every entry is busy the miss
+// waits for the earliest fill to land; returns the cycles it waited
+uint64_t MshrFile::reserve(uint64_t t_block_address, uint64_t t_now) {
+    m_entries.erase(t_block_address);
+    if (static_cast<int>(m_entries.size()) < m_num_entries) {
+        return 0;
+    }
+    auto earliest = m_entries.begin();
+    for (auto it = m_entries.begin(); it != m_entries.end(); ++it) {
+        if (it->second < earliest->second) {
+            earliest = it;
+        }
+    }
+    uint64_t stall = earliest->second > t_now ? earliest->second - t_now : 0;
+    m_entries.erase(earliest);
+    return stall;
+}
+
+// the reserved entry stays busy until the fill completes at t_ready_cycle
+void MshrFile::allocate(uint64_t t_block_address, uint64_t t_ready_cycle) {
+    m_entries[t_block_address] = t_ready_cycle;
+    m_last_completion = std::max(m_last_completion, t_ready_cycle);
+}
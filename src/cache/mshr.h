@@ -0,0 +1,27 @@
+#pragma once
+#include <unordered_map>
+#include <cstdint>
+#include "../exception/cache_exception.h"
+
+// miss-status holding registers of a non-blocking cache level. each entry tracks one outstanding
+// block miss and the cycle its fill completes; later misses to the same block merge into it.
+// time is the issuing core's cycle count, entries retire once the requester's clock passes them
+class MshrFile {
+
+public:
+    explicit MshrFile(int t_num_entries);
+
+    void retire(uint64_t t_now);
+    bool isPending(uint64_t t_block_address, uint64_t& t_ready_cycle) const;
+    uint64_t reserve(uint64_t t_block_address, uint64_t t_now);
+    void allocate(uint64_t t_block_address, uint64_t t_ready_cycle);
+    uint64_t getLastCompletion() const { return m_last_completion; }
+
+    int getNumEntries() const { return m_num_entries; }
+    int getOccupancy() const { return static_cast<int>(m_entries.size()); }
+
+private:
+    int m_num_entries;
+    std::unordered_map<uint64_t, uint64_t> m_entries; // block -> cycle the fill completes
+    uint64_t m_last_completion = 0;
+};
@@ -0,0 +1,131 @@
+#include "prefetcher.h"
+#include <algorithm>
+
+Prefetcher::Prefetcher(int t_degree, int t_block_size) : m_degree(t_degree), m_block_size(t_block_size) {
+    if (m_degree <= 0) {
+        throw CacheException("Prefetch degree must be at least 1.");
+    }
+}
+
+void NextLinePrefetcher::train(uint64_t t_block_address, std::vector<uint64_t>& t_candidates) {
+    for (int i = 1; i <= m_degree; i++) {
+        t_candidates.push_back(t_block_address + (i * m_block_size));
+    }
+}
+
+StridePrefetcher::StridePrefetcher(int t_degree, int t_block_size, int t_table_size) : Prefetcher(t_degree, t_block_size), m_table(t_table_size) {}
+
+void StridePrefetcher::train(uint64_t t_block_address, std::vector<uint64_t>& t_candidates) {
+    m_clock++;
+    int64_t address = static_cast<int64_t>(t_block_address);
+    StrideEntry* predicted = nullptr;
+    StrideEntry* nearest = nullptr;
+    uint64_t nearest_distance = UINT64_MAX;
+    for (StrideEntry& entry : m_table) {
+        if (!entry.m_valid) continue;
+        int64_t delta = address - static_cast<int64_t>(entry.m_last_address);
+        if (delta == 0) {
+            entry.m_last_use = m_clock; // same block again, nothing to learn
+            return;
+        }
+        if (entry.m_stride == delta && (predicted == nullptr || entry.m_confidence > predicted->m_confidence)) {
+            predicted = &entry;
+        }
+        uint64_t distance = (delta > 0) ? static_cast<uint64_t>(delta) : static_cast<uint64_t>(-delta);
+        if (distance < nearest_distance) {
+            nearest = &entry;
+            nearest_distance = distance;
+        }
+    }
+
+    if (predicted == nullptr) {
+        // a new hypothesis: this trigger continues the nearest earlier one
+        StrideEntry* victim = &m_table[0];
+        for (StrideEntry& entry : m_table) {
+            if (!entry.m_valid) {
+                victim = &entry;
+                break;
+            }
+            if (entry.m_last_use < victim->m_last_use) {
+                victim = &entry;
+            }
+        }
+        int64_t stride = (nearest != nullptr) ? address - static_cast<int64_t>(nearest->m_last_address) : 0;
+        *victim = StrideEntry{t_block_address, stride, (stride != 0) ? 1 : 0, m_clock, true};
+        return;
+    }
+
+    predicted->m_confidence = std::min(predicted->m_confidence + 1, CONFIDENCE_THRESHOLD);
+    predicted->m_last_address = t_block_address;
+    predicted->m_last_use = m_clock;
+    if (predicted->m_confidence < CONFIDENCE_THRESHOLD) {
+        return;
+    }
+    for (int i = 1; i <= m_degree; i++) {
+        int64_t target = address + (i * predicted->m_stride);
+        if (target < 0) break;
+        t_candidates.push_back(static_cast<uint64_t>(target));
+    }
+}
+
+StreamPrefetcher::StreamPrefetcher(int t_degree, int t_block_size, int t_num_streams) : Prefetcher(t_degree, t_block_size), m_streams(t_num_streams) {}
+
+void StreamPrefetcher::train(uint64_t t_block_address, std::vector<uint64_t>& t_candidates) {
+    m_clock++;
+    int64_t block = t_block_address / m_block_size;
+
+    for (StreamEntry& stream : m_streams) {
+        if (!stream.m_valid) continue;
+        int64_t distance = block - static_cast<int64_t>(stream.m_last_address / m_block_size);
+        if (distance == 0 || distance > STREAM_WINDOW || distance < -STREAM_WINDOW) continue;
+
+        int direction = (distance > 0) ? 1 : -1;
+        if (stream.m_direction != 0 && stream.m_direction != direction) continue;
+
+        if (stream.m_direction == 0) {
+            // second trigger confirms the direction, start running ahead from here
+            stream.m_direction = direction;
+            stream.m_prefetched_until = t_block_address;
+        }
+        stream.m_last_address = t_block_address;
+        stream.m_last_use = m_clock;
+
+        // stay m_degree blocks ahead of the demand stream
+        int64_t next = static_cast<int64_t>(stream.m_prefetched_until / m_block_size);
+        int64_t limit = block + (direction * m_degree);
+        while ((direction > 0 && next < limit) || (direction < 0 && next > limit)) {
+            next += direction;
+            if (next < 0 || next > (INT64_MAX / m_block_size)) break;
+            t_candidates.push_back(static_cast<uint64_t>(next * m_block_size));
+            stream.m_prefetched_until = static_cast<uint64_t>(next * m_block_size);
+        }
+        return;
+    }
+
+    // no stream matched, replace the least recently used one
+    StreamEntry* victim = &m_streams[0];
+    for (StreamEntry& stream : m_streams) {
+        if (!stream.m_valid) {
+            victim = &stream;
+            break;
+        }
+        if (stream.m_last_use < victim->m_last_use) {
+            victim = &stream;
+        }
+    }
+    *victim = StreamEntry{t_block_address, t_block_address, 0, m_clock, true};
+}
+
+// NONE returns nullptr so callers can skip attaching a prefetcher
+std::unique_ptr<Prefetcher> createPrefetcher(const std::string& t_type, int t_degree, int t_block_size) {
+    if (t_type == "NONE") {
+        return nullptr;
+    } else if (t_type == "NEXT_LINE") {
+        return std::make_unique<NextLinePrefetcher>(t_degree, t_block_size);
+    } else if (t_type == "STRIDE") {
+        return std::make_unique<StridePrefetcher>(t_degree, t_block_size);
+    } else if (t_type == "STREAM") {
+        return std::make_unique<StreamPrefetcher>(t_degree, t_block_size);
+    }
+    throw CacheException("Invalid prefetcher type: " + t_type);
+}
@@ -0,0 +1,86 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <memory>
+#include <cstdint>
+#include "cache_line.h"
+#include "../exception/cache_exception.h"
+
+// hardware prefetcher attached to a single cache level. it is trained on trigger events
+// (demand misses and first demand hits on prefetched lines) and returns the block
+// addresses it wants filled; the cache decides which of them are actually issued
+class Prefetcher {
+
+public:
+    Prefetcher(int t_degree, int t_block_size);
+    virtual ~Prefetcher() = default;
+
+    virtual void train(uint64_t t_block_address, std::vector<uint64_t>& t_candidates) = 0;
+    virtual std::string getName() const = 0;
+    int getDegree() const { return m_degree; }
+
+protected:
+    int m_degree; // blocks requested per trigger
+    int m_block_size; // bytes, block size of the level it fills
+};
+
+// next-N-line: on a trigger for block B, request B+1 .. B+N
+class NextLinePrefetcher : public Prefetcher {
+
+public:
+    explicit NextLinePrefetcher(int t_degree, int t_block_size = defaults::BLOCK_SIZE) : Prefetcher(t_degree, t_block_size) {}
+    void train(uint64_t t_block_address, std::vector<uint64_t>& t_candidates) override;
+    std::string getName() const override { return "NEXT_LINE"; }
+};
+
+// PC-less stride detector. each entry is a stream hypothesis: the last block of the stream and the
+// delta from the nearest earlier trigger that led to it. a trigger one delta past an entry confirms
+// it, and once the delta has repeated the next N strides are requested. any other trigger starts a
+// new entry in place of the least recently used one, so strides of any size are learned and
+// interleaved streams train separate entries
+class StridePrefetcher : public Prefetcher {
+
+public:
+    explicit StridePrefetcher(int t_degree, int t_block_size = defaults::BLOCK_SIZE, int t_table_size = 64);
+    void train(uint64_t t_block_address, std::vector<uint64_t>& t_candidates) override;
+    std::string getName() const override { return "STRIDE"; }
+
+private:
+    struct StrideEntry {
+        uint64_t m_last_address = 0;
+        int64_t m_stride = 0; // 0 until a second trigger is seen
+        int m_confidence = 0; // times the stride was seen, capped at CONFIDENCE_THRESHOLD
+        uint64_t m_last_use = 0;
+        bool m_valid = false;
+    };
+
+    static constexpr int CONFIDENCE_THRESHOLD = 2;
+    std::vector<StrideEntry> m_table;
+    uint64_t m_clock = 0;
+};
+
+// stream buffers: a small set of tracked streams, each with a direction and the next block
+// it expects. a trigger inside a stream's window advances it and runs N blocks ahead,
+// otherwise the least recently used stream is reallocated at the trigger address
+class StreamPrefetcher : public Prefetcher {
+
+public:
+    explicit StreamPrefetcher(int t_degree, int t_block_size = defaults::BLOCK_SIZE, int t_num_streams = 8);
+    void train(uint64_t t_block_address, std::vector<uint64_t>& t_candidates) override;
+    std::string getName() const override { return "STREAM"; }
+
+private:
+    struct StreamEntry {
+        uint64_t m_last_address = 0;
+        uint64_t m_prefetched_until = 0; // furthest block already requested
+        int m_direction = 0; // +1 ascending, -1 descending, 0 = not yet confirmed
+        uint64_t m_last_use = 0;
+        bool m_valid = false;
+    };
+
+    static constexpr int STREAM_WINDOW = 4; // blocks either side of the last trigger still matching a stream
+    std::vector<StreamEntry> m_streams;
+    uint64_t m_clock = 0;
+};
+
+std::unique_ptr<Prefetcher> createPrefetcher(const std::string& t_type, int t_degree, int t_block_size = defaults::BLOCK_SIZE);
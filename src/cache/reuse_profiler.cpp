@@ -0,0 +1,131 @@
+#include "reuse_profiler.h"
+#include <algorithm>
+#include <cmath>
+
+static constexpr uint64_t MIN_SLOTS = 1024;
+
+ReuseProfiler::ReuseProfiler(int t_block_size)
+    : m_tree(MIN_SLOTS + 1, 0),
+    m_reuse_histogram(BUCKETS, 0),
+    m_stack_histogram(BUCKETS, 0) {
+    if (t_block_size <= 0 || (t_block_size & (t_block_size - 1)) != 0) {
+        throw CacheException("Reuse profiler block size must be a power of two.");
+    }
+    m_offset_bits = static_cast<int>(log2(t_block_size));
+}
+
+// bit width of the distance: 0 -> 0, [1, 2) -> 1, [2, 4) -> 2, ...
+int ReuseProfiler::bucketOf(uint64_t t_distance) {
+    if (t_distance == 0) return 0;
+    return std::min(BUCKETS - 1, 64 - __builtin_clzll(t_distance));
+}
+
+void ReuseProfiler::record(uint64_t t_address) {
+    uint64_t block = t_address >> m_offset_bits;
+    if (m_next_slot + 1 >= m_tree.size()) {
+        compactSlots();
+    }
+    uint64_t slot = m_next_slot++;
+    m_accesses++;
+
+    auto it = m_last_use.find(block);
+    if (it == m_last_use.end()) {
+        m_cold_accesses++;
+        m_last_use.emplace(block, LastUse{slot, m_clock});
+    } else {
+        LastUse& last = it->second;
+        uint64_t reuse = m_clock - last.m_access - 1;
+        // every live marker sits before the new slot, so the blocks touched since are the live
+        // markers after the block's own one
+        uint64_t stack = m_last_use.size() - countMarkers(last.m_slot + 1);
+        m_reuse_histogram[bucketOf(reuse)]++;
+        m_stack_histogram[bucketOf(stack)]++;
+        addMarker(last.m_slot, -1);
+        last.m_slot = slot;
+        last.m_access = m_clock;
+    }
+    addMarker(slot, 1);
+    m_clock++;
+}
+
+void ReuseProfiler::resetCounts() {
+    m_accesses = 0;
+    m_cold_accesses = 0;
+    std::fill(m_reuse_histogram.begin(), m_reuse_histogram.end(), 0);
+    std::fill(m_stack_histogram.begin(), m_stack_histogram.end(), 0);
+}
+
+void ReuseProfiler::addMarker(uint64_t t_slot, int t_delta) {
+    for (uint64_t i = t_slot + 1; i < m_tree.size(); i += i & (~i + 1)) {
+        m_tree[i] += t_delta;
+    }
+}
+
+uint64_t ReuseProfiler::countMarkers(uint64_t t_slots) const {
+    uint64_t count = 0;
+    for (uint64_t i = t_slots; i > 0; i -= i & (~i + 1)) {
+        count += m_tree[i];
+    }
+    return count;
+}
+
+// renumbers the live markers to 0..k-1 in recency order and rebuilds the tree with room for
+// as many new accesses again. a tree twice the live blocks stays cache resident while compactions
+// remain rare, so the amortized cost per access stays logarithmic
+void ReuseProfiler::compactSlots() {
+    std::vector<uint32_t> new_slot(m_next_slot, 0);
+    for (const auto& entry : m_last_use) {
+        new_slot[entry.second.m_slot] = 1;
+    }
+    uint32_t live = 0;
+    for (uint64_t slot = 0; slot < m_next_slot; slot++) {
+        uint32_t marked = new_slot[slot];
+        new_slot[slot] = live;
+        live += marked;
+    }
+    for (auto& entry : m_last_use) {
+        entry.second.m_slot = new_slot[entry.second.m_slot];
+    }
+
+    uint64_t capacity = std::max<uint64_t>(MIN_SLOTS, 2 * static_cast<uint64_t>(live));
+    m_tree.assign(capacity + 1, 0);
+    std::fill(m_tree.begin() + 1, m_tree.begin() + 1 + live, 1);
+    // linear Fenwick build, each node pushes its sum to its parent
+    for (uint64_t i = 1; i < m_tree.size(); i++) {
+        uint64_t parent = i + (i & (~i + 1));
+        if (parent < m_tree.size()) {
+            m_tree[parent] += m_tree[i];
+        }
+    }
+    m_next_slot = live;
+}
+
+// the cumulative stack distance share is the hit rate of a fully associative LRU cache holding
+// that many blocks, the usual starting point for sizing a level
+void ReuseProfiler::printSummary(const std::string& t_label) const {
+    std::cout << "\n===== Reuse Distance (" << t_label << ") =====\n";
+    std::cout << "Accesses: " << m_accesses << "\n";
+    std::cout << "Cold Accesses: " << m_cold_accesses << "\n";
+    std::cout << "Distinct Blocks: " << m_last_use.size() << " (" << (m_last_use.size() << m_offset_bits) / 1024.0 << " KB)\n";
+    std::cout << "Distance Bucket: Reuse (accesses) | Stack (unique blocks) | LRU Hit Rate At Capacity\n";
+    uint64_t cumulative = 0;
+    for (int bucket = 0; bucket < BUCKETS; bucket++) {
+        cumulative += m_stack_histogram[bucket];
+        if (m_reuse_histogram[bucket] == 0 && m_stack_histogram[bucket] == 0) continue;
+        if (bucket == 0) {
+            std::cout << "  0: ";
+        } else if (bucket == BUCKETS - 1) {
+            std::cout << "  [" << (1ULL << (bucket - 1)) << ", inf): ";
+        } else {
+            std::cout << "  [" << (1ULL << (bucket - 1)) << ", " << (1ULL << bucket) << "): ";
+        }
+        std::cout << m_reuse_histogram[bucket] << " | " << m_stack_histogram[bucket];
+        if (bucket < BUCKETS - 1) {
+            uint64_t capacity_bytes = (1ULL << bucket) << m_offset_bits;
+            std::cout << " | " << (m_accesses == 0 ? 0.0 : 100.0 * cumulative / m_accesses) << "% at "
+                      << capacity_bytes / 1024.0 << " KB";
+        }
+        std::cout << "\n";
+    }
+    std::cout << "====================================\n";
+}
@@ -0,0 +1,52 @@
+#pragma once
+#include <unordered_map>
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <iostream>
+#include "../exception/cache_exception.h"
+
+// reuse distance histograms of a block stream. for every access to a block seen before it counts
+// the accesses (reuse distance) and the distinct blocks (stack distance) since the previous access
+// to it. the stack distance is the smallest fully associative LRU cache, in blocks, that would hit.
+// a Fenwick tree over access slots keeps one marker per block at its latest access, so a stack
+// distance is a range count in O(log n); slots are renumbered when they run out, which keeps the
+// tree proportional to the number of distinct blocks instead of the trace length
+class ReuseProfiler {
+
+public:
+    static constexpr int BUCKETS = 34; // bucket 0 = distance 0, bucket i = [2^(i-1), 2^i), last open ended
+
+    explicit ReuseProfiler(int t_block_size);
+
+    void record(uint64_t t_address);
+    void resetCounts(); // keeps the recency state, only the histograms start over
+    void printSummary(const std::string& t_label) const;
+
+    uint64_t getAccesses() const { return m_accesses; }
+    uint64_t getColdAccesses() const { return m_cold_accesses; }
+    uint64_t getDistinctBlocks() const { return m_last_use.size(); }
+    const std::vector<uint64_t>& getReuseHistogram() const { return m_reuse_histogram; }
+    const std::vector<uint64_t>& getStackHistogram() const { return m_stack_histogram; }
+    static int bucketOf(uint64_t t_distance);
+
+private:
+    struct LastUse {
+        uint64_t m_slot; // position of the block's marker in the tree
+        uint64_t m_access; // access count when the block was last touched
+    };
+
+    void addMarker(uint64_t t_slot, int t_delta);
+    uint64_t countMarkers(uint64_t t_slots) const; // markers in slots [0, t_slots)
+    void compactSlots();
+
+    int m_offset_bits;
+    std::unordered_map<uint64_t, LastUse> m_last_use; // block -> its latest access
+    std::vector<uint32_t> m_tree; // Fenwick tree over slots, 1-based
+    uint64_t m_next_slot = 0;
+    uint64_t m_clock = 0; // every access recorded, histograms reset or not
+    uint64_t m_accesses = 0;
+    uint64_t m_cold_accesses = 0; // first touch of a block, no finite distance
+    std::vector<uint64_t> m_reuse_histogram;
+    std::vector<uint64_t> m_stack_histogram;
+};
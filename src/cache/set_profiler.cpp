@@ -0,0 +1,58 @@
+#include "set_profiler.h"
+#include <algorithm>
+
+SetProfiler::SetProfiler(int t_num_sets, int t_top_k)
+    : m_sets(t_num_sets),
+    m_top_k(t_top_k) {
+    if (t_num_sets <= 0 || t_top_k < 0) {
+        throw CacheException("Set profiler needs at least one set and a non-negative number of reported blocks.");
+    }
+    if (t_top_k > 0) {
+        m_hot_blocks = std::make_unique<HeavyHitters>(t_top_k * COUNTERS_PER_REPORTED_BLOCK);
+        m_missed_blocks = std::make_unique<HeavyHitters>(t_top_k * COUNTERS_PER_REPORTED_BLOCK);
+    }
+}
+
+void SetProfiler::resetCounts() {
+    std::fill(m_sets.begin(), m_sets.end(), SetCounters{});
+    if (m_hot_blocks != nullptr) {
+        m_hot_blocks->clear();
+        m_missed_blocks->clear();
+    }
+}
+
+std::vector<HeavyHitters::Counter> SetProfiler::getHotBlocks() const {
+    return m_hot_blocks != nullptr ? m_hot_blocks->top(m_top_k) : std::vector<HeavyHitters::Counter>();
+}
+
+std::vector<HeavyHitters::Counter> SetProfiler::getMissedBlocks() const {
+    return m_missed_blocks != nullptr ? m_missed_blocks->top(m_top_k) : std::vector<HeavyHitters::Counter>();
+}
+
+void SetProfiler::writeSetHeader(std::ostream& t_out) {
+    t_out << "cache,set,accesses,misses,evictions,miss_rate\n";
+}
+
+void SetProfiler::writeSets(std::ostream& t_out, const std::string& t_cache) const {
+    for (size_t set = 0; set < m_sets.size(); set++) {
+        const SetCounters& counters = m_sets[set];
+        double miss_rate = counters.m_accesses == 0 ? 0.0 : static_cast<double>(counters.m_misses) / counters.m_accesses;
+        t_out << t_cache << "," << set << "," << counters.m_accesses << "," << counters.m_misses << ","
+              << counters.m_evictions << "," << miss_rate << "\n";
+    }
+}
+
+void SetProfiler::writeHotBlockHeader(std::ostream& t_out) {
+    t_out << "cache,ranking,rank,block_address,count,max_overcount\n";
+}
+
+void SetProfiler::writeHotBlocks(std::ostream& t_out, const std::string& t_cache) const {
+    auto write = [&](const char* t_ranking, const std::vector<HeavyHitters::Counter>& t_blocks) {
+        for (size_t rank = 0; rank < t_blocks.size(); rank++) {
+            t_out << t_cache << "," << t_ranking << "," << rank + 1 << ",0x" << std::hex << t_blocks[rank].m_key << std::dec
+                  << "," << t_blocks[rank].m_count << "," << t_blocks[rank].m_error << "\n";
+        }
+    };
+    write("accesses", getHotBlocks());
+    write("misses", getMissedBlocks());
+}
@@ -0,0 +1,55 @@
+#pragma once
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include "heavy_hitters.h"
+
+// per-set heat map of one cache plus the hottest and most-missed blocks. the set counters sit in
+// one contiguous array indexed by set, so counting an access is a single increment next to the
+// set's other counters; the block rankings are Space-Saving sketches with a few times more
+// counters than reported, which keeps their error small without tracking every block. with no
+// reported blocks the sketches are not built, and an access costs only the set's increments
+class SetProfiler {
+
+public:
+    struct SetCounters {
+        uint64_t m_accesses = 0;
+        uint64_t m_misses = 0;
+        uint64_t m_evictions = 0;
+    };
+
+    static constexpr int COUNTERS_PER_REPORTED_BLOCK = 4;
+
+    SetProfiler(int t_num_sets, int t_top_k); // t_top_k = 0 keeps the heat map only
+
+    void recordAccess(int t_set, uint64_t t_block_address, bool t_hit) {
+        SetCounters& set = m_sets[t_set];
+        set.m_accesses++;
+        set.m_misses += t_hit ? 0 : 1;
+        if (m_hot_blocks != nullptr) {
+            m_hot_blocks->add(t_block_address);
+            if (!t_hit) m_missed_blocks->add(t_block_address);
+        }
+    }
+    void recordEviction(int t_set) { m_sets[t_set].m_evictions++; }
+    void resetCounts();
+
+    // one CSV row per set / per reported block, prefixed with the cache's label
+    void writeSets(std::ostream& t_out, const std::string& t_cache) const;
+    void writeHotBlocks(std::ostream& t_out, const std::string& t_cache) const;
+    static void writeSetHeader(std::ostream& t_out);
+    static void writeHotBlockHeader(std::ostream& t_out);
+
+    const std::vector<SetCounters>& getSets() const { return m_sets; }
+    bool tracksBlocks() const { return m_hot_blocks != nullptr; }
+    std::vector<HeavyHitters::Counter> getHotBlocks() const;
+    std::vector<HeavyHitters::Counter> getMissedBlocks() const;
+
+private:
+    std::vector<SetCounters> m_sets;
+    int m_top_k;
+    std::unique_ptr<HeavyHitters> m_hot_blocks; // by accesses, nullptr without reported blocks
+    std::unique_ptr<HeavyHitters> m_missed_blocks; // by misses
+};
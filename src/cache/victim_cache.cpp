@@ -0,0 +1,55 @@
+#include "victim_cache.h"
+
+VictimCache::VictimCache(int t_num_entries) : m_num_entries(t_num_entries) {
+    if (m_num_entries <= 0) {
+        throw CacheException("Victim cache must have at least one entry.");
+    }
+    m_lookup.reserve(m_num_entries);
+}
+
+// on hit the entry leaves the buffer (it is swapped back into the cache)
+bool VictimCache::extract(uint64_t t_block_address, CacheLine& t_line) {
+    auto it = m_lookup.find(t_block_address);
+    if (it == m_lookup.end()) {
+        return false;
+    }
+    t_line = it->second->m_line;
+    m_entries.erase(it->second);
+    m_lookup.erase(it);
+    return true;
+}
+
+// returns the displaced LRU entry when the buffer is full so the owner can write it back
+std::optional<VictimEntry> VictimCache::insert(uint64_t t_block_address, const CacheLine& t_line) {
+    auto existing = m_lookup.find(t_block_address);
+    if (existing != m_lookup.end()) {
+        m_entries.erase(existing->second);
+        m_lookup.erase(existing);
+    }
+
+    std::optional<VictimEntry> displaced;
+    if (static_cast<int>(m_entries.size()) >= m_num_entries) {
+        displaced = std::move(m_entries.back());
+        m_lookup.erase(displaced->m_block_address);
+        m_entries.pop_back();
+    }
+
+    m_entries.push_front(VictimEntry{t_block_address, t_line});
+    m_lookup[t_block_address] = m_entries.begin();
+    return displaced;
+}
+
+void VictimCache::forEachDirtyEntry(const std::function<void(uint64_t, CacheLine&)>& t_callback) {
+    for (VictimEntry& entry : m_entries) {
+        if (entry.m_line.m_dirty) {
+            t_callback(entry.m_block_address, entry.m_line);
+        }
+    }
+}
+
+// oldest first, so inserting the entries in this order rebuilds the same LRU order
+void VictimCache::forEachEntry(const std::function<void(const VictimEntry&)>& t_callback) const {
+    for (auto it = m_entries.rbegin(); it != m_entries.rend(); ++it) {
+        t_callback(*it);
+    }
+}
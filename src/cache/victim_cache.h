@@ -0,0 +1,35 @@
+#pragma once
+#include <list>
+#include <unordered_map>
+#include <optional>
+#include <functional>
+#include <cstdint>
+#include "cache_line.h"
+#include "../exception/cache_exception.h"
+
+struct VictimEntry {
+    uint64_t m_block_address;
+    CacheLine m_line;
+};
+
+// small fully associative buffer holding lines recently evicted from a cache level.
+// a hash map indexes into an LRU ordered list so probe, insert and extract are all O(1)
+class VictimCache {
+
+public:
+    explicit VictimCache(int t_num_entries);
+
+    bool extract(uint64_t t_block_address, CacheLine& t_line);
+    std::optional<VictimEntry> insert(uint64_t t_block_address, const CacheLine& t_line);
+    void forEachDirtyEntry(const std::function<void(uint64_t, CacheLine&)>& t_callback);
+    void forEachEntry(const std::function<void(const VictimEntry&)>& t_callback) const; // oldest first
+
+    bool contains(uint64_t t_block_address) const { return m_lookup.count(t_block_address) != 0; }
+    int getNumEntries() const { return m_num_entries; }
+    int getSize() const { return static_cast<int>(m_entries.size()); }
+
+private:
+    int m_num_entries;
+    std::list<VictimEntry> m_entries; // front = most recently inserted
+    std::unordered_map<uint64_t, std::list<VictimEntry>::iterator> m_lookup;
+};
@@ -0,0 +1,55 @@
+#include "write_buffer.h"
+
+WriteBuffer::WriteBuffer(int t_num_entries, int t_block_size) : m_num_entries(t_num_entries), m_block_size(t_block_size) {
+    if (m_num_entries <= 0) {
+        throw CacheException("Write buffer must have at least one entry.");
+    }
+    if (t_block_size <= 0 || m_block_size / sizeof(int) > 64) {
+        throw CacheException("Write buffer blocks must hold between 1 and 64 words.");
+    }
+    m_lookup.reserve(m_num_entries);
+}
+
+// merges the store into the entry of its block, returns false when the block is not buffered
+bool WriteBuffer::coalesce(uint64_t t_address, int t_value) {
+    auto it = m_lookup.find(t_address & ~(m_block_size - 1));
+    if (it == m_lookup.end()) {
+        return false;
+    }
+    size_t word = (t_address & (m_block_size - 1)) / sizeof(int);
+    it->second->m_data[word] = t_value;
+    it->second->m_word_mask |= (1ULL << word);
+    return true;
+}
+
+// the caller drains an entry first when the buffer is full
+void WriteBuffer::insert(uint64_t t_address, int t_value) {
+    if (isFull()) {
+        throw CacheException("Write buffer insert while full.");
+    }
+    uint64_t block_address = t_address & ~(m_block_size - 1);
+    m_entries.push_back(WriteBufferEntry{block_address, std::vector<int>(m_block_size / sizeof(int), 0), 0});
+    m_lookup[block_address] = std::prev(m_entries.end());
+    coalesce(t_address, t_value);
+}
+
+std::optional<WriteBufferEntry> WriteBuffer::popOldest() {
+    if (m_entries.empty()) {
+        return std::nullopt;
+    }
+    WriteBufferEntry entry = m_entries.front();
+    m_lookup.erase(entry.m_block_address);
+    m_entries.pop_front();
+    return entry;
+}
+
+bool WriteBuffer::extract(uint64_t t_block_address, WriteBufferEntry& t_entry) {
+    auto it = m_lookup.find(t_block_address);
+    if (it == m_lookup.end()) {
+        return false;
+    }
+    t_entry = *it->second;
+    m_entries.erase(it->second);
+    m_lookup.erase(it);
+    return true;
+}
@@ -0,0 +1,41 @@
+#pragma once
+#include <list>
+#include <unordered_map>
+#include <optional>
+#include <cstdint>
+#include <vector>
+#include "cache_line.h"
+#include "../exception/cache_exception.h"
+
+// stores waiting to drain to the next level, one entry per block. a bit per word tracks
+// which words were written so draining only sends those
+struct WriteBufferEntry {
+    uint64_t m_block_address;
+    std::vector<int> m_data;
+    uint64_t m_word_mask = 0; // blocks are limited to 64 words
+};
+
+// write-combining buffer of a write-through level. stores to a block that is already
+// buffered coalesce into its entry; entries drain oldest first
+class WriteBuffer {
+
+public:
+    explicit WriteBuffer(int t_num_entries, int t_block_size = defaults::BLOCK_SIZE);
+
+    bool coalesce(uint64_t t_address, int t_value);
+    void insert(uint64_t t_address, int t_value);
+    std::optional<WriteBufferEntry> popOldest();
+    bool extract(uint64_t t_block_address, WriteBufferEntry& t_entry);
+
+    bool contains(uint64_t t_block_address) const { return m_lookup.count(t_block_address) != 0; }
+    bool isFull() const { return static_cast<int>(m_entries.size()) >= m_num_entries; }
+    bool isEmpty() const { return m_entries.empty(); }
+    int getNumEntries() const { return m_num_entries; }
+    int getSize() const { return static_cast<int>(m_entries.size()); }
+
+private:
+    int m_num_entries;
+    uint64_t m_block_size;
+    std::list<WriteBufferEntry> m_entries; // front = oldest
+    std::unordered_map<uint64_t, std::list<WriteBufferEntry>::iterator> m_lookup;
+};
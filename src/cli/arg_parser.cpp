@@ -12,11 +12,11 @@ ArgParser::~ArgParser() {
 
 // EXAMPLE: ./cache_sim -cache_size medium -threads 4 -policy LRU -assoc 1 -write_policy WB -trace memory_access.txt --verbose
 bool ArgParser::validateArguments() {
-    if (m_argc != 12 && m_argc != 13) {
+    if (m_argc < 12) {
         return false;
     }
     return validateCaches() && validateThreads() && validatePolicy() && 
-    validateAssociativity() && validateWritePolicy() && validateTraceAndVerbose();
+    validateAssociativity() && validateWritePolicy() && validateTrace() && validateOptionalArguments();
 }
 
 bool ArgParser::isNumber(const std::string& t_str) {
@@ -43,25 +43,232 @@ bool ArgParser::validateThreads() {
 }
 
 bool ArgParser::validatePolicy() {
-    return m_argument[4] == "-policy" && 
-    (m_argument[5] == "LRU" || m_argument[5] == "FIFO" || m_argument[5] == "LFU");
+    return m_argument[4] == "-policy" && isValidReplacementPolicy(m_argument[5]);
+}
+
+bool ArgParser::isValidReplacementPolicy(const std::string& t_policy) {
+    return t_policy == "LRU" || t_policy == "FIFO" || t_policy == "LFU" || t_policy == "PLRU";
 }
 
 bool ArgParser::validateAssociativity() {
     if (!isNumber(m_argument[7]) || m_argument[6] != "-assoc") { return false;
 }
-    int assocNum = std::stoi(m_argument[7]);
-    return assocNum == 1 || assocNum == 4 || assocNum == 8 ||assocNum == 0;
+    return isValidAssociativity(m_argument[7]);
+}
+
+// 0 = fully associative, otherwise any number of ways up to 64
+bool ArgParser::isValidAssociativity(const std::string& t_assoc) {
+    return isNumber(t_assoc) && t_assoc.size() <= 2 && std::stoi(t_assoc) <= 64;
+}
+
+// comma separated sweep values, e.g. "16KB,32KB,64KB". empty items make the list invalid
+std::vector<std::string> ArgParser::splitList(const std::string& t_list) {
+    std::vector<std::string> items;
+    std::stringstream stream(t_list);
+    std::string item;
+    while (std::getline(stream, item, ',')) {
+        if (item.empty()) return {};
+        items.push_back(item);
+    }
+    if (!t_list.empty() && t_list.back() == ',') return {};
+    return items;
+}
+
+// config files hold the optional arguments one per line, "key value" or "key = value" for
+// flags and a bare key for switches; '#' starts a comment. the entries are appended after the
+// command line so flags given there take precedence
+bool ArgParser::loadConfigFile(const std::string& t_path) {
+    std::ifstream file(t_path);
+    if (!file.is_open()) {
+        return false;
+    }
+    std::string line;
+    while (std::getline(file, line)) {
+        line = line.substr(0, line.find('#'));
+        std::replace(line.begin(), line.end(), '=', ' ');
+        std::istringstream stream(line);
+        std::vector<std::string> tokens;
+        std::string token;
+        while (stream >> token) {
+            tokens.push_back(token);
+        }
+        if (tokens.empty()) {
+            continue;
+        }
+        if (tokens.size() == 1 && isSwitch("--" + tokens[0])) {
+            m_argument.push_back("--" + tokens[0]);
+        } else if (tokens.size() == 2 && tokens[0] != "config") {
+            m_argument.push_back("-" + tokens[0]);
+            m_argument.push_back(tokens[1]);
+        } else {
+            return false;
+        }
+    }
+    m_argc = static_cast<int>(m_argument.size());
+    return true;
 }
 
 bool ArgParser::validateWritePolicy() {
     return m_argument[8] == "-write_policy" && (m_argument[9] == "WB" || m_argument[9] == "WT");
 }
 
-bool ArgParser::validateTraceAndVerbose() {
-    bool isTraceValid = m_argument[10] == "-trace" && !m_argument[11].empty();
-    bool isVerboseValid = (m_argc == 13) ? (m_argument[12] == "--verbose") : true;
-    return isTraceValid && isVerboseValid;
+bool ArgParser::validateTrace() {
+    return m_argument[10] == "-trace" && !m_argument[11].empty();
+}
+
+// optional arguments follow the trace file in any order, either as a
+// standalone switch (--verbose) or as a "-flag <value>" pair
+bool ArgParser::validateOptionalArguments() {
+    for (int i = REQUIRED_ARGS; i < m_argc; i++) {
+        const std::string flag = m_argument[i];
+        if (isSwitch(flag)) {
+            continue;
+        }
+        if (i + 1 >= m_argc) {
+            return false;
+        }
+        const std::string value = m_argument[++i];
+        if (flag == "-l2_inclusion" || flag == "-l3_inclusion") {
+            if (!isValidInclusionPolicy(value)) return false;
+        } else if (flag == "-victim_cache") {
+            if (!isNumber(value) || value.size() > 4 || std::stoi(value) > 1024) return false;
+        } else if (flag == "-l1_prefetch" || flag == "-l2_prefetch" || flag == "-l3_prefetch") {
+            if (!isValidPrefetcher(value)) return false;
+        } else if (flag == "-l1_latency" || flag == "-l2_latency" || flag == "-l3_latency" ||
+                   flag == "-memory_latency" || flag == "-writeback_latency") {
+            if (!isNumber(value) || value.size() > 6) return false;
+        } else if (flag == "-dram_channels" || flag == "-dram_ranks" || flag == "-dram_banks") {
+            if (!isNumber(value) || value.size() > 3 || std::stoi(value) < 1) return false;
+        } else if (flag == "-dram_row_size") {
+            if (!isNumber(value) || value.size() > 7 || std::stoi(value) < 64 || std::stoi(value) % 64 != 0) return false;
+        } else if (flag == "-dram_row_policy") {
+            if (value != "OPEN" && value != "CLOSED") return false;
+        } else if (flag == "-dram_trcd" || flag == "-dram_tcas" || flag == "-dram_trp") {
+            if (!isNumber(value) || value.size() > 4) return false;
+        } else if (flag == "-l1_mshrs" || flag == "-l2_mshrs" || flag == "-l3_mshrs") {
+            if (!isNumber(value) || value.size() > 2 || std::stoi(value) > 64) return false;
+        } else if (flag == "-l1_block_size" || flag == "-l2_block_size" || flag == "-l3_block_size") {
+            if (value != "16" && value != "32" && value != "64" && value != "128" && value != "256") return false;
+        } else if (flag == "-l1_size" || flag == "-l2_size" || flag == "-l3_size") {
+            if (parseCacheSize(value) < 0) return false;
+        } else if (flag == "-l1_assoc" || flag == "-l2_assoc" || flag == "-l3_assoc") {
+            if (!isValidAssociativity(value)) return false;
+        } else if (flag == "-l1_policy" || flag == "-l2_policy" || flag == "-l3_policy") {
+            if (!isValidReplacementPolicy(value)) return false;
+        } else if (flag == "-l1_write_policy" || flag == "-l2_write_policy" || flag == "-l3_write_policy") {
+            if (value != "WB" && value != "WT") return false;
+        } else if (flag == "-sweep_l1_size" || flag == "-sweep_l2_size" || flag == "-sweep_l3_size") {
+            std::vector<std::string> sizes = splitList(value);
+            if (sizes.empty() || !std::all_of(sizes.begin(), sizes.end(), [](const std::string& s) { return parseCacheSize(s) > 0; })) return false;
+        } else if (flag == "-sweep_assoc") {
+            std::vector<std::string> assocs = splitList(value);
+            if (assocs.empty() || !std::all_of(assocs.begin(), assocs.end(), isValidAssociativity)) return false;
+        } else if (flag == "-sweep_policy") {
+            std::vector<std::string> policies = splitList(value);
+            if (policies.empty() || !std::all_of(policies.begin(), policies.end(), isValidReplacementPolicy)) return false;
+        } else if (flag == "-sweep_write_policy") {
+            std::vector<std::string> policies = splitList(value);
+            if (policies.empty() || !std::all_of(policies.begin(), policies.end(),
+                [](const std::string& s) { return s == "WB" || s == "WT"; })) return false;
+        } else if (flag == "-sweep_jobs") {
+            if (!isNumber(value) || value.size() > 3 || std::stoi(value) > 256) return false;
+        } else if (flag == "-sweep_lockstep") {
+            if (!isNumber(value) || value.size() > 7 || std::stoi(value) > 1024 * 1024) return false;
+        } else if (flag == "-sweep_output") {
+            if (value.empty()) return false;
+        } else if (flag == "-l3_set_sampling") {
+            if (!isNumber(value) || value.size() > 4 || std::stoi(value) < 1 || std::stoi(value) > 1024) return false;
+        } else if (flag == "-time_sampling" || flag == "-sample_unit") {
+            if (!isNumber(value) || value.size() > 9) return false;
+        } else if (flag == "-checkpoint_save" || flag == "-checkpoint_restore") {
+            if (value.empty()) return false;
+        } else if (flag == "-checkpoint_at" || flag == "-warmup") {
+            if (!isNumber(value) || value.size() > 9) return false;
+        } else if (flag == "-set_heatmap" || flag == "-hot_blocks" || flag == "-stats_json" || flag == "-stats_csv" || flag == "-interval_log") {
+            if (value.empty()) return false;
+        } else if (flag == "-interval" || flag == "-interval_cycles") {
+            if (!isNumber(value) || value.size() > 12 || std::stoll(value) < 1) return false;
+        } else if (flag == "-top_k") {
+            if (!isNumber(value) || value.size() > 4 || std::stoi(value) < 1) return false;
+        } else if (flag == "-config") {
+            if (m_config_loaded || !loadConfigFile(value)) return false;
+            m_config_loaded = true;
+        } else if (flag == "-write_allocate") {
+            if (value != "WA" && value != "NWA") return false;
+        } else if (flag == "-write_buffer") {
+            if (!isNumber(value) || value.size() > 2 || std::stoi(value) > 64) return false;
+        } else if (flag == "-write_buffer_drain") {
+            if (value != "FULL" && value != "IDLE") return false;
+        } else if (flag == "-prefetch_degree") {
+            if (!isNumber(value) || value.size() > 2 || std::stoi(value) < 1 || std::stoi(value) > 16) return false;
+        } else {
+            return false;
+        }
+    }
+    // each time-sampling period must have room for its detailed unit
+    int period = std::stoi(getOption("-time_sampling", "0"));
+    int unit = std::stoi(getOption("-sample_unit", "1000"));
+    if (period != 0 && (unit <= 0 || unit > period)) {
+        return false;
+    }
+    // checkpoints snapshot one core's hierarchy, so they need a single-threaded run outside sweep mode
+    bool checkpointing = hasFlag("-checkpoint_save") || hasFlag("-checkpoint_restore");
+    bool sweeping = hasFlag("-sweep_l1_size") || hasFlag("-sweep_l2_size") || hasFlag("-sweep_l3_size")
+        || hasFlag("-sweep_assoc") || hasFlag("-sweep_policy") || hasFlag("-sweep_write_policy");
+    if (checkpointing && (std::stoi(m_argument[3]) != 1 || sweeping)) {
+        return false;
+    }
+    // only the single-core hierarchy alternates detailed units and functional warming, which sweep points reuse
+    if (period != 0 && std::stoi(m_argument[3]) != 1 && !sweeping) {
+        return false;
+    }
+    // every sweep point replays the same trace, so its reuse profile and heat maps are taken from a normal run
+    if ((hasFlag("--reuse_distance") || hasFlag("-set_heatmap") || hasFlag("-hot_blocks")) && sweeping) {
+        return false;
+    }
+    // a sweep already writes one CSV row per configuration with -sweep_output
+    if ((hasFlag("-stats_json") || hasFlag("-stats_csv")) && sweeping) {
+        return false;
+    }
+    // the interval log needs exactly one way of closing intervals, counted in requests or in cycles
+    bool interval_given = hasFlag("-interval") || hasFlag("-interval_cycles");
+    if (hasFlag("-interval_log") != interval_given || (hasFlag("-interval") && hasFlag("-interval_cycles"))
+        || (interval_given && sweeping)) {
+        return false;
+    }
+    return !hasFlag("-checkpoint_at") || hasFlag("-checkpoint_save");
+}
+
+bool ArgParser::isValidInclusionPolicy(const std::string& t_policy) {
+    return t_policy == "INCLUSIVE" || t_policy == "EXCLUSIVE" || t_policy == "NINE";
+}
+
+bool ArgParser::isValidPrefetcher(const std::string& t_prefetcher) {
+    return t_prefetcher == "NONE" || t_prefetcher == "NEXT_LINE" || t_prefetcher == "STRIDE" || t_prefetcher == "STREAM";
+}
+
+// switches are optional arguments that take no value
+bool ArgParser::isSwitch(const std::string& t_flag) {
+    return t_flag == "--verbose" || t_flag == "--dram" || t_flag == "--full_address_space" || t_flag == "--sample_all_levels" || t_flag == "--reuse_distance"
+        || t_flag == "--classify_misses" || t_flag == "--self_profile"
+        || t_flag == "--perf_counters";
+}
+
+bool ArgParser::hasFlag(const std::string& t_flag) const {
+    for (int i = REQUIRED_ARGS; i < m_argc; i++) {
+        if (m_argument[i] == t_flag) return true;
+        if (!isSwitch(m_argument[i])) i++; // skip the flag's value
+    }
+    return false;
+}
+
+std::string ArgParser::getOption(const std::string& t_flag, const std::string& t_default) const {
+    for (int i = REQUIRED_ARGS; i < m_argc; i++) {
+        if (isSwitch(m_argument[i])) continue;
+        if (m_argument[i] == t_flag && i + 1 < m_argc) return m_argument[i + 1];
+        i++;
+    }
+    return t_default;
 }
 
 ValidParams ArgParser::getValidParams() {
@@ -77,7 +284,81 @@ ValidParams ArgParser::getValidParams() {
     params.associativity = std::stoi(m_argument[7]);
     params.write_policy = m_argument[9];
     params.access_file_name = m_argument[11];
-    params.isVerbose = (m_argc == 13);
+    params.isVerbose = hasFlag("--verbose");
+    params.l2_inclusion_policy = getOption("-l2_inclusion", params.l2_inclusion_policy);
+    params.l3_inclusion_policy = getOption("-l3_inclusion", params.l3_inclusion_policy);
+    params.victim_cache_entries = std::stoi(getOption("-victim_cache", "0"));
+    params.l1_prefetcher = getOption("-l1_prefetch", params.l1_prefetcher);
+    params.l2_prefetcher = getOption("-l2_prefetch", params.l2_prefetcher);
+    params.l3_prefetcher = getOption("-l3_prefetch", params.l3_prefetcher);
+    params.prefetch_degree = std::stoi(getOption("-prefetch_degree", "1"));
+    params.l1_mshrs = std::stoi(getOption("-l1_mshrs", "0"));
+    params.l2_mshrs = std::stoi(getOption("-l2_mshrs", "0"));
+    params.l3_mshrs = std::stoi(getOption("-l3_mshrs", "0"));
+    params.l1_cache_size = (hasFlag("-l1_size")) ? parseCacheSize(getOption("-l1_size", "")) : params.l1_cache_size;
+    params.l2_cache_size = (hasFlag("-l2_size")) ? parseCacheSize(getOption("-l2_size", "")) : params.l2_cache_size;
+    params.l3_cache_size = (hasFlag("-l3_size")) ? parseCacheSize(getOption("-l3_size", "")) : params.l3_cache_size;
+    params.l1_associativity = std::stoi(getOption("-l1_assoc", m_argument[7]));
+    params.l2_associativity = std::stoi(getOption("-l2_assoc", m_argument[7]));
+    params.l3_associativity = std::stoi(getOption("-l3_assoc", m_argument[7]));
+    params.l1_replacement_policy = getOption("-l1_policy", params.replacement_policy);
+    params.l2_replacement_policy = getOption("-l2_policy", params.replacement_policy);
+    params.l3_replacement_policy = getOption("-l3_policy", params.replacement_policy);
+    params.l1_write_policy = getOption("-l1_write_policy", params.write_policy);
+    params.l2_write_policy = getOption("-l2_write_policy", params.write_policy);
+    params.l3_write_policy = getOption("-l3_write_policy", params.write_policy);
+    for (const std::string& size : splitList(getOption("-sweep_l1_size", ""))) params.sweep_l1_sizes.push_back(parseCacheSize(size));
+    for (const std::string& size : splitList(getOption("-sweep_l2_size", ""))) params.sweep_l2_sizes.push_back(parseCacheSize(size));
+    for (const std::string& size : splitList(getOption("-sweep_l3_size", ""))) params.sweep_l3_sizes.push_back(parseCacheSize(size));
+    for (const std::string& assoc : splitList(getOption("-sweep_assoc", ""))) params.sweep_associativities.push_back(std::stoi(assoc));
+    params.sweep_policies = splitList(getOption("-sweep_policy", ""));
+    params.sweep_write_policies = splitList(getOption("-sweep_write_policy", ""));
+    params.sweep_jobs = std::stoi(getOption("-sweep_jobs", "0"));
+    params.sweep_output = getOption("-sweep_output", "");
+    params.l3_set_sampling = std::stoi(getOption("-l3_set_sampling", "1"));
+    params.sweep_lockstep_batch = std::stoi(getOption("-sweep_lockstep", "0"));
+    params.sweep_enabled = hasFlag("-sweep_l1_size") || hasFlag("-sweep_l2_size") || hasFlag("-sweep_l3_size")
+        || hasFlag("-sweep_assoc") || hasFlag("-sweep_policy") || hasFlag("-sweep_write_policy");
+    params.l1_block_size = std::stoi(getOption("-l1_block_size", std::to_string(params.l1_block_size)));
+    params.l2_block_size = std::stoi(getOption("-l2_block_size", std::to_string(params.l2_block_size)));
+    params.l3_block_size = std::stoi(getOption("-l3_block_size", std::to_string(params.l3_block_size)));
+    params.write_allocate = getOption("-write_allocate", params.write_allocate);
+    params.write_buffer_entries = std::stoi(getOption("-write_buffer", "0"));
+    params.write_buffer_drain = getOption("-write_buffer_drain", params.write_buffer_drain);
+    params.dram_enabled = hasFlag("--dram");
+    params.full_address_space = hasFlag("--full_address_space");
+    params.sample_all_levels = hasFlag("--sample_all_levels");
+    params.reuse_distance = hasFlag("--reuse_distance");
+    params.classify_misses = hasFlag("--classify_misses");
+    params.perf_counters = hasFlag("--perf_counters");
+    params.self_profile = hasFlag("--self_profile") || params.perf_counters;
+    params.time_sample_period = std::stoi(getOption("-time_sampling", "0"));
+    params.time_sample_unit = std::stoi(getOption("-sample_unit", "1000"));
+    params.warmup_requests = std::stoi(getOption("-warmup", "0"));
+    params.set_heatmap = getOption("-set_heatmap", "");
+    params.hot_blocks = getOption("-hot_blocks", "");
+    params.top_k = std::stoi(getOption("-top_k", std::to_string(params.top_k)));
+    params.stats_json = getOption("-stats_json", "");
+    params.stats_csv = getOption("-stats_csv", "");
+    params.interval_log = getOption("-interval_log", "");
+    params.interval_requests = std::stoull(getOption("-interval", "0"));
+    params.interval_cycles = std::stoull(getOption("-interval_cycles", "0"));
+    params.checkpoint_save = getOption("-checkpoint_save", "");
+    params.checkpoint_at = std::stoi(getOption("-checkpoint_at", "0"));
+    params.checkpoint_restore = getOption("-checkpoint_restore", "");
+    params.dram.channels = std::stoi(getOption("-dram_channels", std::to_string(params.dram.channels)));
+    params.dram.ranks = std::stoi(getOption("-dram_ranks", std::to_string(params.dram.ranks)));
+    params.dram.banks = std::stoi(getOption("-dram_banks", std::to_string(params.dram.banks)));
+    params.dram.row_size = std::stoi(getOption("-dram_row_size", std::to_string(params.dram.row_size)));
+    params.dram.row_policy = getOption("-dram_row_policy", params.dram.row_policy);
+    params.dram.t_rcd = std::stoi(getOption("-dram_trcd", std::to_string(params.dram.t_rcd)));
+    params.dram.t_cas = std::stoi(getOption("-dram_tcas", std::to_string(params.dram.t_cas)));
+    params.dram.t_rp = std::stoi(getOption("-dram_trp", std::to_string(params.dram.t_rp)));
+    params.l1_latency = std::stoi(getOption("-l1_latency", std::to_string(params.l1_latency)));
+    params.l2_latency = std::stoi(getOption("-l2_latency", std::to_string(params.l2_latency)));
+    params.l3_latency = std::stoi(getOption("-l3_latency", std::to_string(params.l3_latency)));
+    params.memory_latency = std::stoi(getOption("-memory_latency", std::to_string(params.memory_latency)));
+    params.writeback_latency = std::stoi(getOption("-writeback_latency", std::to_string(params.writeback_latency)));
 
     return params;
 }
\ No newline at end of file
@@ -2,7 +2,11 @@
 #include <string>
 #include <vector>
 #include <algorithm>
+#include <fstream>
+#include <sstream>
 #include "../cache/cache_config.h"
+#include "../cache/cache_line.h"
+#include "../memory/dram.h"
 
 struct ValidParams {
     int l1_cache_size;
@@ -11,10 +15,73 @@ struct ValidParams {
     std::string memory_size;
     int num_threads;
     std::string replacement_policy;
+    std::string l1_replacement_policy; // per level, default to replacement_policy
+    std::string l2_replacement_policy;
+    std::string l3_replacement_policy;
     std::string access_file_name;
     int associativity;
+    int l1_associativity; // per level, default to associativity
+    int l2_associativity;
+    int l3_associativity;
     std::string write_policy;
+    std::string l1_write_policy; // per level, default to write_policy
+    std::string l2_write_policy;
+    std::string l3_write_policy;
     bool isVerbose;
+    int l1_block_size = defaults::BLOCK_SIZE; // bytes
+    int l2_block_size = defaults::BLOCK_SIZE;
+    int l3_block_size = defaults::BLOCK_SIZE;
+    std::string l2_inclusion_policy = "NINE"; // INCLUSIVE, EXCLUSIVE or NINE
+    std::string l3_inclusion_policy = "NINE";
+    int victim_cache_entries = 0; // entries in the L1 victim cache, 0 = disabled
+    std::string l1_prefetcher = "NONE"; // NONE, NEXT_LINE, STRIDE or STREAM
+    std::string l2_prefetcher = "NONE";
+    std::string l3_prefetcher = "NONE";
+    int prefetch_degree = 1;
+    int l1_mshrs = 0; // outstanding misses per level, 0 = blocking
+    int l2_mshrs = 0;
+    int l3_mshrs = 0;
+    std::string write_allocate = "WA"; // WA or NWA, applies to every level
+    int write_buffer_entries = 0; // write-combining buffer of each WT level, 0 = disabled
+    std::string write_buffer_drain = "FULL"; // FULL or IDLE
+    int l1_latency = defaults::L1_HIT_LATENCY; // cycles
+    int l2_latency = defaults::L2_HIT_LATENCY;
+    int l3_latency = defaults::L3_HIT_LATENCY;
+    int memory_latency = defaults::MEMORY_LATENCY;
+    int writeback_latency = defaults::WRITEBACK_LATENCY;
+    int l3_set_sampling = 1; // simulate every Nth L3 set and extrapolate, 1 = every set
+    bool sample_all_levels = false; // drop requests to unsampled L3 sets before they reach L1
+    int time_sample_period = 0; // requests per time-sampling period, 0 = every request in detail
+    int time_sample_unit = 1000; // detailed requests at the end of each period
+    bool reuse_distance = false; // record reuse and stack distance histograms of the trace
+    bool classify_misses = false; // split each level's misses into compulsory, capacity, conflict and coherence
+    bool self_profile = false; // time the simulator's own phases, threads and fm_mutex contention
+    bool perf_counters = false; // add host hardware counters to the self-profile, implies self_profile
+    int warmup_requests = 0; // first requests simulated but excluded from the statistics
+    std::string set_heatmap; // CSV of per-set accesses, misses and evictions of every cache, empty = none
+    std::string hot_blocks; // CSV of the hottest and most-missed blocks of every cache, empty = none
+    int top_k = 10; // blocks reported per cache and ranking
+    std::string stats_json; // machine-readable copy of the summary, empty = none
+    std::string stats_csv; // the same fields as a one-row CSV, empty = none
+    std::string interval_log; // CSV time series of the statistics, empty = none
+    uint64_t interval_requests = 0; // requests per interval of the log
+    uint64_t interval_cycles = 0; // or simulated cycles per interval
+    std::string checkpoint_save; // checkpoint file written during the run, empty = none
+    int checkpoint_at = 0; // trace position to save at and stop, 0 = end of the trace
+    std::string checkpoint_restore; // checkpoint file the run resumes from, empty = cold start
+    bool full_address_space = false; // accept any 64-bit trace address instead of the memory size window
+    std::vector<int> sweep_l1_sizes; // sweep mode lists, an empty list keeps the single value above
+    std::vector<int> sweep_l2_sizes;
+    std::vector<int> sweep_l3_sizes;
+    std::vector<int> sweep_associativities;
+    std::vector<std::string> sweep_policies;
+    std::vector<std::string> sweep_write_policies;
+    int sweep_jobs = 0; // worker threads, 0 = one per hardware thread
+    std::string sweep_output; // CSV results file, empty = stdout
+    int sweep_lockstep_batch = 0; // requests per lockstep batch, 0 = every point replays the trace on its own
+    bool sweep_enabled = false;
+    bool dram_enabled = false; // time memory requests with the DRAM model instead of memory_latency
+    DramConfig dram;
 };
 
 class ArgParser {
@@ -26,15 +93,28 @@ public:
     ValidParams getValidParams();
 
 private:
+    static constexpr int REQUIRED_ARGS = 12;
+
     int m_argc;
     std::vector<std::string> m_argument;
+    bool m_config_loaded = false;
 
     bool validateCaches();
     bool validateThreads();
     bool validatePolicy();
     bool validateAssociativity();
     bool validateWritePolicy();
-    bool validateTraceAndVerbose();
+    bool validateTrace();
+    bool validateOptionalArguments();
+    bool hasFlag(const std::string& t_flag) const;
+    std::string getOption(const std::string& t_flag, const std::string& t_default) const;
 
     static bool isNumber(const std::string& t_str);
+    static bool isValidInclusionPolicy(const std::string& t_policy);
+    static bool isValidPrefetcher(const std::string& t_prefetcher);
+    static bool isValidReplacementPolicy(const std::string& t_policy);
+    static bool isValidAssociativity(const std::string& t_assoc);
+    static std::vector<std::string> splitList(const std::string& t_list);
+    bool loadConfigFile(const std::string& t_path);
+    static bool isSwitch(const std::string& t_flag);
 };
\ No newline at end of file
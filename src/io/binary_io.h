@@ -0,0 +1,41 @@
+#pragma once
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <type_traits>
+#include <vector>
+#include "../exception/cache_exception.h"
+
+// fixed width values for the checkpoint format, written in host byte order
+namespace binary_io {
+
+template <typename T>
+void write(std::ostream& t_out, const T& t_value) {
+    static_assert(std::is_trivially_copyable<T>::value, "only plain values can be written raw");
+    t_out.write(reinterpret_cast<const char*>(&t_value), sizeof(T));
+}
+
+template <typename T>
+T read(std::istream& t_in) {
+    static_assert(std::is_trivially_copyable<T>::value, "only plain values can be read raw");
+    T value{};
+    if (!t_in.read(reinterpret_cast<char*>(&value), sizeof(T))) {
+        throw CacheException("Checkpoint is truncated or unreadable.");
+    }
+    return value;
+}
+
+// any contiguous int container with data() and size(), a std::vector or a line's LineData
+template <typename Words>
+inline void writeWords(std::ostream& t_out, const Words& t_words) {
+    t_out.write(reinterpret_cast<const char*>(t_words.data()), t_words.size() * sizeof(int));
+}
+
+template <typename Words>
+inline void readWords(std::istream& t_in, Words& t_words) {
+    if (!t_in.read(reinterpret_cast<char*>(t_words.data()), t_words.size() * sizeof(int))) {
+        throw CacheException("Checkpoint is truncated or unreadable.");
+    }
+}
+
+}
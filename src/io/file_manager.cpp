@@ -30,6 +30,27 @@ std::optional<MemoryRequest> FileManager::getNextRequest() {
     return request;
 }
 
+std::vector<MemoryRequest> FileManager::takeRequests() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::vector<MemoryRequest> requests;
+    requests.reserve(m_requests.size());
+    while (!m_requests.empty()) {
+        requests.push_back(m_requests.front());
+        m_requests.pop();
+    }
+    return requests;
+}
+
+void FileManager::skipRequests(uint64_t t_count) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (t_count > m_requests.size()) {
+        throw CacheException("[ERROR] Trace has fewer than " + std::to_string(t_count) + " requests to skip.");
+    }
+    for (uint64_t i = 0; i < t_count; i++) {
+        m_requests.pop();
+    }
+}
+
 void FileManager::parseFile() {
     std::ifstream file((m_isTest ? "examples/tests/" : "examples/") + m_filename);
     if (!file.is_open()) {
@@ -56,7 +77,7 @@ void FileManager::parseFile() {
                 clearRequests();
                 throw CacheException("[ERROR] Invalid read format: " + line);
             }
-            uint32_t address = std::stoul(tokens[1], nullptr, 16);
+            uint64_t address = std::stoull(tokens[1], nullptr, 16);
             MemoryRequest request(READ, address);
             m_requests.push(request);
         } else if (tokens[0] == "W") {
@@ -64,7 +85,7 @@ void FileManager::parseFile() {
                 clearRequests();
                 throw CacheException("[ERROR] Invalid write format: " + line);
             }
-            uint32_t address = std::stoul(tokens[1], nullptr, 16);
+            uint64_t address = std::stoull(tokens[1], nullptr, 16);
             int value = std::stoi(tokens[2]);
             MemoryRequest request(WRITE, address, value);
             m_requests.push(request);
@@ -85,8 +106,9 @@ std::vector<std::string> FileManager::splitBySpace(const std::string& input) {
     return tokens;
 }
 
+// up to 16 hex digits, addresses are 64-bit
 bool FileManager::isValidHexAddress(const std::string& address) {
-    return address.size() > 2 && address[0] == '0' && address[1] == 'x' && 
+    return address.size() > 2 && address.size() <= 18 && address[0] == '0' && address[1] == 'x' && 
            address.find_first_not_of("0123456789abcdefABCDEF", 2) == std::string::npos;
 }
 
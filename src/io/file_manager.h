@@ -8,6 +8,7 @@
 #include <filesystem>
 #include <optional>
 #include <algorithm>
+#include <vector>
 #include "../exception/cache_exception.h"
 
 enum AccessType {
@@ -17,10 +18,10 @@ enum AccessType {
 
 struct MemoryRequest {
     AccessType type;
-    uint32_t address;
+    uint64_t address;
     int value;
 
-    MemoryRequest(AccessType t_type, uint32_t t_address, int t_value = 0)
+    MemoryRequest(AccessType t_type, uint64_t t_address, int t_value = 0)
         : type(t_type), address(t_address), value(t_value) {}
 };
 
@@ -33,6 +34,8 @@ class FileManager {
         void parseFile();
         std::optional<MemoryRequest> getNextRequest();
         int getNumOperations() const;
+        std::vector<MemoryRequest> takeRequests(); // hands every parsed request over in trace order
+        void skipRequests(uint64_t t_count); // drops the first requests, e.g. the ones a checkpoint already covers
     
     private:
         std::string m_filename;
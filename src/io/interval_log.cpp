@@ -0,0 +1,136 @@
+#include "interval_log.h"
+
+IntervalSnapshot IntervalSnapshot::capture(const CacheStats& t_stats, uint64_t t_requests) {
+    IntervalSnapshot snapshot;
+    snapshot.requests = t_requests;
+    snapshot.cycles = t_stats.total_cycles;
+    snapshot.l1_hits = t_stats.l1_hits;
+    snapshot.l1_misses = t_stats.l1_misses;
+    snapshot.l2_hits = t_stats.l2_hits;
+    snapshot.l2_misses = t_stats.l2_misses;
+    snapshot.l3_hits = t_stats.l3_hits;
+    snapshot.l3_misses = t_stats.l3_misses;
+    snapshot.evictions = t_stats.evictions;
+    snapshot.dirty_evictions = t_stats.dirty_evictions;
+    snapshot.memory_accesses = t_stats.memory_accesses;
+    snapshot.coherence_invalidations = t_stats.coherence_invalidations;
+    snapshot.coherence_downgrades = t_stats.coherence_downgrades;
+    snapshot.coherence_writebacks = t_stats.coherence_writebacks;
+    return snapshot;
+}
+
+IntervalLog::IntervalLog(const std::string& t_path, uint64_t t_every_requests, uint64_t t_every_cycles)
+    : m_out(t_path), m_every_requests(t_every_requests), m_every_cycles(t_every_cycles), m_next_cycle_boundary(t_every_cycles) {
+    if ((t_every_requests == 0) == (t_every_cycles == 0)) {
+        throw CacheException("Interval log needs either a request or a cycle interval.");
+    }
+    if (!m_out.is_open()) {
+        throw CacheException("Failed to open interval log file: " + t_path);
+    }
+    writeHeader(m_out);
+    m_writer = std::thread(&IntervalLog::writerLoop, this);
+}
+
+IntervalLog::~IntervalLog() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_done = true;
+    }
+    m_ready.notify_one();
+    if (m_writer.joinable()) {
+        m_writer.join();
+    }
+}
+
+void IntervalLog::closeInterval(const CacheStats& t_stats) {
+    if (m_every_cycles != 0) {
+        // a long access may cross several boundaries, the next one is the first still ahead
+        m_next_cycle_boundary = (t_stats.total_cycles / m_every_cycles + 1) * m_every_cycles;
+    }
+    m_last_closed = m_requests;
+    push(IntervalSnapshot::capture(t_stats, m_requests));
+}
+
+void IntervalLog::markCountersReset(const CacheStats& t_stats) {
+    IntervalSnapshot snapshot = IntervalSnapshot::capture(t_stats, m_requests);
+    snapshot.counters_reset = true;
+    m_last_closed = m_requests;
+    if (m_every_cycles != 0) {
+        m_next_cycle_boundary = m_every_cycles; // total_cycles restarts from zero too
+    }
+    push(snapshot);
+}
+
+void IntervalLog::finish(const CacheStats& t_stats) {
+    if (m_requests != m_last_closed) {
+        closeInterval(t_stats);
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_done = true;
+    }
+    m_ready.notify_one();
+    m_writer.join();
+    m_out.flush();
+}
+
+void IntervalLog::push(const IntervalSnapshot& t_snapshot) {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_pending.push_back(t_snapshot);
+    }
+    m_ready.notify_one();
+}
+
+// takes the whole queue at once so the simulation thread only ever waits for a swap
+void IntervalLog::writerLoop() {
+    IntervalSnapshot previous;
+    uint64_t interval = 0;
+    std::vector<IntervalSnapshot> batch;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_ready.wait(lock, [this] { return m_done || !m_pending.empty(); });
+            if (m_pending.empty() && m_done) {
+                return;
+            }
+            batch.swap(m_pending);
+        }
+        for (const IntervalSnapshot& snapshot : batch) {
+            if (snapshot.requests != previous.requests) {
+                writeRow(m_out, interval++, previous, snapshot);
+            }
+            previous = snapshot;
+            if (snapshot.counters_reset) {
+                // later snapshots count from zero, only the request count carries on
+                previous = IntervalSnapshot();
+                previous.requests = snapshot.requests;
+            }
+        }
+        batch.clear();
+    }
+}
+
+void IntervalLog::writeHeader(std::ostream& t_out) {
+    t_out << "interval,first_request,last_request,start_cycle,end_cycle,requests,cycles,"
+          << "l1_hit_rate,l2_hit_rate,l3_hit_rate,l1_misses,l2_misses,l3_misses,evictions,writebacks,memory_accesses,"
+          << "coherence_invalidations,coherence_downgrades,coherence_writebacks\n";
+}
+
+void IntervalLog::writeRow(std::ostream& t_out, uint64_t t_interval, const IntervalSnapshot& t_start, const IntervalSnapshot& t_end) {
+    auto rate = [](uint64_t hits, uint64_t misses) {
+        return (hits + misses) == 0 ? 0.0 : 100.0 * hits / (hits + misses);
+    };
+    uint64_t l1_hits = t_end.l1_hits - t_start.l1_hits, l1_misses = t_end.l1_misses - t_start.l1_misses;
+    uint64_t l2_hits = t_end.l2_hits - t_start.l2_hits, l2_misses = t_end.l2_misses - t_start.l2_misses;
+    uint64_t l3_hits = t_end.l3_hits - t_start.l3_hits, l3_misses = t_end.l3_misses - t_start.l3_misses;
+    t_out << t_interval << "," << t_start.requests << "," << t_end.requests - 1 << "," << t_start.cycles << "," << t_end.cycles << ","
+          << t_end.requests - t_start.requests << "," << t_end.cycles - t_start.cycles << ","
+          << rate(l1_hits, l1_misses) << "," << rate(l2_hits, l2_misses) << "," << rate(l3_hits, l3_misses) << ","
+          << l1_misses << "," << l2_misses << "," << l3_misses << ","
+          << t_end.evictions - t_start.evictions << "," << t_end.dirty_evictions - t_start.dirty_evictions << ","
+          << t_end.memory_accesses - t_start.memory_accesses << ","
+          << t_end.coherence_invalidations - t_start.coherence_invalidations << ","
+          << t_end.coherence_downgrades - t_start.coherence_downgrades << ","
+          << t_end.coherence_writebacks - t_start.coherence_writebacks << "\n";
+}
@@ -0,0 +1,70 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <fstream>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include "../cache/cache.h"
+
+// cumulative counters at one interval boundary, small enough to copy on the simulation thread
+struct IntervalSnapshot {
+    uint64_t requests = 0; // requests seen by the log since the run started
+    uint64_t cycles = 0; // CacheStats::total_cycles
+    uint64_t l1_hits = 0, l1_misses = 0;
+    uint64_t l2_hits = 0, l2_misses = 0;
+    uint64_t l3_hits = 0, l3_misses = 0;
+    uint64_t evictions = 0;
+    uint64_t dirty_evictions = 0;
+    uint64_t memory_accesses = 0;
+    uint64_t coherence_invalidations = 0;
+    uint64_t coherence_downgrades = 0;
+    uint64_t coherence_writebacks = 0;
+    bool counters_reset = false; // the counters restart from zero after this snapshot
+
+    static IntervalSnapshot capture(const CacheStats& t_stats, uint64_t t_requests);
+};
+
+// time series of the statistics for phase analysis: an interval closes every N requests, or every
+// N simulated cycles, and one CSV row holds what happened in it. the simulation thread only copies
+// the cumulative counters into a queue; a background thread takes the differences, formats and
+// writes the rows, so file output never stalls a worker
+class IntervalLog {
+
+public:
+    IntervalLog(const std::string& t_path, uint64_t t_every_requests, uint64_t t_every_cycles);
+    ~IntervalLog();
+
+    // called before each request is simulated, so a closed interval holds only finished requests.
+    // a counter compare and an increment unless the interval is full
+    void observe(const CacheStats& t_stats) {
+        if ((m_every_requests != 0 && m_requests - m_last_closed == m_every_requests)
+            || (m_every_cycles != 0 && t_stats.total_cycles >= m_next_cycle_boundary)) {
+            closeInterval(t_stats);
+        }
+        m_requests++;
+    }
+    void markCountersReset(const CacheStats& t_stats); // closes the interval before the counters are zeroed
+    void finish(const CacheStats& t_stats); // closes the last, partial interval and waits for the writer
+
+    static void writeHeader(std::ostream& t_out);
+    static void writeRow(std::ostream& t_out, uint64_t t_interval, const IntervalSnapshot& t_start, const IntervalSnapshot& t_end);
+
+private:
+    void closeInterval(const CacheStats& t_stats);
+    void push(const IntervalSnapshot& t_snapshot);
+    void writerLoop();
+
+    std::ofstream m_out;
+    uint64_t m_every_requests;
+    uint64_t m_every_cycles;
+    uint64_t m_requests = 0;
+    uint64_t m_next_cycle_boundary;
+    uint64_t m_last_closed = 0; // requests at the last boundary, an empty interval is not logged
+    std::mutex m_mutex;
+    std::condition_variable m_ready;
+    std::vector<IntervalSnapshot> m_pending; // guarded by m_mutex
+    bool m_done = false; // guarded by m_mutex
+    std::thread m_writer;
+};
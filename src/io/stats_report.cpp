@@ -0,0 +1,273 @@
+#include "stats_report.h"
+#include <iomanip>
+#include <sstream>
+#include <cmath>
+#include <algorithm>
+
+void StatsReport::addRun(const ValidParams& t_params, double t_wall_seconds, uint64_t t_requests) {
+    add("run", "trace", t_params.access_file_name);
+    add("run", "threads", t_params.num_threads);
+    add("run", "requests", t_requests);
+    add("run", "wall_time_ms", t_wall_seconds * 1000.0);
+    add("run", "requests_per_second", t_wall_seconds > 0 ? t_requests / t_wall_seconds : 0.0);
+}
+
+void StatsReport::addConfig(const ValidParams& t_params) {
+    add("config", "memory_size", t_params.memory_size);
+    struct LevelConfig {
+        const char* name;
+        int size, associativity, block_size, latency;
+        const std::string& replacement, &write;
+    };
+    for (const LevelConfig& level : {
+            LevelConfig{"l1", t_params.l1_cache_size, t_params.l1_associativity, t_params.l1_block_size, t_params.l1_latency, t_params.l1_replacement_policy, t_params.l1_write_policy},
+            LevelConfig{"l2", t_params.l2_cache_size, t_params.l2_associativity, t_params.l2_block_size, t_params.l2_latency, t_params.l2_replacement_policy, t_params.l2_write_policy},
+            LevelConfig{"l3", t_params.l3_cache_size, t_params.l3_associativity, t_params.l3_block_size, t_params.l3_latency, t_params.l3_replacement_policy, t_params.l3_write_policy}}) {
+        std::string prefix = level.name;
+        add("config", prefix + "_size", level.size);
+        add("config", prefix + "_associativity", level.associativity);
+        add("config", prefix + "_block_size", level.block_size);
+        add("config", prefix + "_replacement_policy", level.replacement);
+        add("config", prefix + "_write_policy", level.write);
+        add("config", prefix + "_hit_latency", level.latency);
+    }
+    add("config", "l2_inclusion_policy", t_params.l2_inclusion_policy);
+    add("config", "l3_inclusion_policy", t_params.l3_inclusion_policy);
+    add("config", "write_allocate", t_params.write_allocate);
+    add("config", "write_buffer_entries", t_params.write_buffer_entries);
+    add("config", "write_buffer_drain", t_params.write_buffer_drain);
+    add("config", "victim_cache_entries", t_params.victim_cache_entries);
+    add("config", "l1_prefetcher", t_params.l1_prefetcher);
+    add("config", "l2_prefetcher", t_params.l2_prefetcher);
+    add("config", "l3_prefetcher", t_params.l3_prefetcher);
+    add("config", "prefetch_degree", t_params.prefetch_degree);
+    add("config", "l1_mshrs", t_params.l1_mshrs);
+    add("config", "l2_mshrs", t_params.l2_mshrs);
+    add("config", "l3_mshrs", t_params.l3_mshrs);
+    add("config", "memory_latency", t_params.memory_latency);
+    add("config", "writeback_latency", t_params.writeback_latency);
+    add("config", "dram", t_params.dram_enabled);
+    add("config", "l3_set_sampling", t_params.l3_set_sampling);
+    add("config", "time_sample_period", t_params.time_sample_period);
+    add("config", "time_sample_unit", t_params.time_sample_unit);
+    add("config", "warmup_requests", t_params.warmup_requests);
+    add("config", "checkpoint_restore", t_params.checkpoint_restore);
+}
+
+void StatsReport::addCacheStats(const CacheStats& t_stats) {
+    add("operations", "total", t_stats.total_operations);
+    add("operations", "reads", t_stats.read_operations);
+    add("operations", "writes", t_stats.write_operations);
+    add("operations", "warmup_requests", t_stats.warmup_requests);
+
+    struct LevelStats {
+        const char* name;
+        int hits, misses;
+        const MissBreakdown& classes;
+    };
+    for (const LevelStats& level : {
+            LevelStats{"l1", t_stats.l1_hits, t_stats.l1_misses, t_stats.l1_miss_classes},
+            LevelStats{"l2", t_stats.l2_hits, t_stats.l2_misses, t_stats.l2_miss_classes},
+            LevelStats{"l3", t_stats.l3_hits, t_stats.l3_misses, t_stats.l3_miss_classes}}) {
+        int accesses = level.hits + level.misses;
+        add(level.name, "hits", level.hits);
+        add(level.name, "misses", level.misses);
+        add(level.name, "hit_rate", accesses == 0 ? 0.0 : 100.0 * level.hits / accesses);
+        if (t_stats.classify_misses) {
+            add(level.name, "compulsory_misses", level.classes.compulsory);
+            add(level.name, "capacity_misses", level.classes.capacity);
+            add(level.name, "conflict_misses", level.classes.conflict);
+            add(level.name, "coherence_misses", level.classes.coherence);
+        }
+    }
+
+    add("hierarchy", "evictions", t_stats.evictions);
+    add("hierarchy", "dirty_evictions", t_stats.dirty_evictions);
+    add("hierarchy", "memory_accesses", t_stats.memory_accesses);
+    add("hierarchy", "back_invalidations", t_stats.back_invalidations);
+    add("hierarchy", "exclusive_fills", t_stats.exclusive_fills);
+    add("hierarchy", "coherence_invalidations", t_stats.coherence_invalidations);
+    add("hierarchy", "coherence_downgrades", t_stats.coherence_downgrades);
+    add("hierarchy", "coherence_writebacks", t_stats.coherence_writebacks);
+
+    add("victim_cache", "hits", t_stats.victim_hits);
+    add("victim_cache", "misses", t_stats.victim_misses);
+    add("victim_cache", "swaps", t_stats.victim_swaps);
+
+    add("prefetch", "issued", t_stats.prefetches_issued);
+    add("prefetch", "useful", t_stats.prefetch_useful);
+    add("prefetch", "late", t_stats.prefetch_late);
+    add("prefetch", "unused", t_stats.prefetch_unused);
+    add("prefetch", "level_misses", t_stats.prefetch_level_misses);
+    add("prefetch", "accuracy", t_stats.prefetchAccuracy());
+    add("prefetch", "coverage", t_stats.prefetchCoverage());
+
+    add("writes", "allocate_fills", t_stats.write_allocate_fills);
+    add("writes", "fills_evicted_unread", t_stats.write_fills_unread);
+    add("writes", "arounds", t_stats.write_arounds);
+    add("writes", "fill_words_saved", t_stats.write_fill_words_saved);
+    add("writes", "buffer_stores", t_stats.write_buffer_stores);
+    add("writes", "buffer_coalesced", t_stats.write_buffer_coalesced);
+    add("writes", "buffer_drains", t_stats.write_buffer_drains);
+    add("writes", "buffer_drained_words", t_stats.write_buffer_drained_words);
+    add("writes", "buffer_full_stalls", t_stats.write_buffer_full_stalls);
+
+    add("mshr", "allocations", t_stats.mshr_allocations);
+    add("mshr", "merged", t_stats.mshr_merged);
+    add("mshr", "full_stalls", t_stats.mshr_full_stalls);
+    add("mshr", "stall_cycles", t_stats.mshr_stall_cycles);
+    add("mshr", "average_occupancy", t_stats.averageMshrOccupancy());
+    add("mshr", "peak_occupancy", t_stats.mshr_peak_occupancy);
+
+    add("timing", "total_cycles", t_stats.total_cycles);
+    add("timing", "amat", t_stats.averageMemoryAccessTime());
+    for (size_t core = 0; core < t_stats.core_cycles.size(); core++) {
+        add("core_cycles", std::to_string(core), t_stats.core_cycles[core]);
+    }
+    // named by the lower bound of each bucket in cycles
+    for (int bucket = 0; bucket < CacheStats::LATENCY_BUCKETS; bucket++) {
+        add("latency_histogram", std::to_string(1ULL << bucket), t_stats.latency_histogram[bucket]);
+    }
+
+    if (t_stats.l3_sample_ratio > 1) {
+        add("l3_set_sampling", "ratio", t_stats.l3_sample_ratio);
+        add("l3_set_sampling", "total_sets", t_stats.l3_total_sets);
+        add("l3_set_sampling", "sampled_sets", t_stats.l3_sample_accesses.size());
+        add("l3_set_sampling", "skipped_accesses", t_stats.l3_skipped_accesses);
+        add("l3_set_sampling", "filtered_requests", t_stats.l3_filtered_requests);
+        add("l3_set_sampling", "miss_rate", t_stats.sampledL3MissRate());
+        add("l3_set_sampling", "miss_rate_ci95", t_stats.sampledL3MissRateError());
+        add("l3_set_sampling", "extrapolated_misses", t_stats.extrapolatedL3Misses());
+    }
+    if (t_stats.time_sample_period > 0) {
+        auto cycles = t_stats.sampledRate([](const SampleUnit& unit) { return unit.cycles; });
+        auto l1 = t_stats.sampledRate([](const SampleUnit& unit) { return unit.l1_misses; });
+        auto l2 = t_stats.sampledRate([](const SampleUnit& unit) { return unit.l2_misses; });
+        auto l3 = t_stats.sampledRate([](const SampleUnit& unit) { return unit.l3_misses; });
+        uint64_t requests = t_stats.total_operations + t_stats.warmed_requests;
+        add("time_sampling", "period", t_stats.time_sample_period);
+        add("time_sampling", "units", t_stats.sample_units.size());
+        add("time_sampling", "warmed_requests", t_stats.warmed_requests);
+        add("time_sampling", "cycles_per_access", cycles.first);
+        add("time_sampling", "cycles_per_access_ci95", cycles.second);
+        add("time_sampling", "l1_misses_per_1000", 1000 * l1.first);
+        add("time_sampling", "l1_misses_per_1000_ci95", 1000 * l1.second);
+        add("time_sampling", "l2_misses_per_1000", 1000 * l2.first);
+        add("time_sampling", "l2_misses_per_1000_ci95", 1000 * l2.second);
+        add("time_sampling", "l3_misses_per_1000", 1000 * l3.first);
+        add("time_sampling", "l3_misses_per_1000_ci95", 1000 * l3.second);
+        add("time_sampling", "extrapolated_cycles", static_cast<uint64_t>(cycles.first * requests));
+    }
+}
+
+void StatsReport::addDram(const DramStats& t_stats) {
+    add("dram", "reads", t_stats.reads);
+    add("dram", "writes", t_stats.writes);
+    add("dram", "row_hits", t_stats.row_hits);
+    add("dram", "row_empty", t_stats.row_empty);
+    add("dram", "row_conflicts", t_stats.row_conflicts);
+    add("dram", "row_hit_rate", t_stats.rowHitRate());
+    add("dram", "average_latency", t_stats.averageLatency());
+}
+
+// host counters that were not counted are left out rather than reported as zero
+void StatsReport::addCounters(const std::string& t_prefix, const PerfSample& t_counters) {
+    for (int counter = 0; counter < PerfSample::COUNTERS; counter++) {
+        if (t_counters.counted[counter]) {
+            add("self_profile", t_prefix + PerfSample::counterName(counter), t_counters.values[counter]);
+        }
+    }
+}
+
+void StatsReport::addSelfProfile(const SelfProfile& t_profile) {
+    const auto& phases = t_profile.getPhases();
+    for (size_t i = 0; i < phases.size(); i++) {
+        add("self_profile", phases[i].first + "_seconds", std::chrono::duration<double>(phases[i].second).count());
+        addCounters(phases[i].first + "_", t_profile.getPhaseCounters()[i]);
+    }
+    add("self_profile", "requests_per_second", t_profile.requestsPerSecond());
+    const std::vector<ThreadProfile>& threads = t_profile.getThreads();
+    for (size_t thread = 0; thread < threads.size(); thread++) {
+        std::string prefix = "thread" + std::to_string(thread) + "_";
+        add("self_profile", prefix + "requests", threads[thread].requests);
+        add("self_profile", prefix + "simulating_seconds", std::chrono::duration<double>(threads[thread].simulating()).count());
+        add("self_profile", prefix + "lock_wait_seconds", std::chrono::duration<double>(threads[thread].lock_wait).count());
+        add("self_profile", prefix + "idle_seconds", std::chrono::duration<double>(threads[thread].idle()).count());
+        add("self_profile", prefix + "lock_acquisitions", threads[thread].lock_acquisitions);
+        add("self_profile", prefix + "contended_acquisitions", threads[thread].contended_acquisitions);
+        addCounters(prefix, threads[thread].counters);
+    }
+}
+
+// one object per section in order of first appearance, fields of a section stay together
+void StatsReport::writeJson(std::ostream& t_out) const {
+    std::vector<std::string> sections;
+    for (const Field& field : m_fields) {
+        if (std::find(sections.begin(), sections.end(), field.m_section) == sections.end()) {
+            sections.push_back(field.m_section);
+        }
+    }
+    t_out << "{";
+    for (size_t s = 0; s < sections.size(); s++) {
+        t_out << (s == 0 ? "\n" : ",\n") << "  \"" << escapeJson(sections[s]) << "\": {";
+        bool first = true;
+        for (const Field& field : m_fields) {
+            if (field.m_section != sections[s]) continue;
+            t_out << (first ? "\n" : ",\n") << "    \"" << escapeJson(field.m_name) << "\": ";
+            if (field.m_text) {
+                t_out << "\"" << escapeJson(field.m_value) << "\"";
+            } else {
+                t_out << field.m_value;
+            }
+            first = false;
+        }
+        t_out << "\n  }";
+    }
+    t_out << "\n}\n";
+}
+
+void StatsReport::writeCsv(std::ostream& t_out) const {
+    for (size_t i = 0; i < m_fields.size(); i++) {
+        t_out << (i == 0 ? "" : ",") << escapeCsv(m_fields[i].m_section + "." + m_fields[i].m_name);
+    }
+    t_out << "\n";
+    for (size_t i = 0; i < m_fields.size(); i++) {
+        t_out << (i == 0 ? "" : ",") << (m_fields[i].m_text ? escapeCsv(m_fields[i].m_value) : m_fields[i].m_value);
+    }
+    t_out << "\n";
+}
+
+std::string StatsReport::formatReal(double t_value) {
+    if (!std::isfinite(t_value)) {
+        return "null"; // NaN and infinities have no JSON form
+    }
+    std::ostringstream out;
+    out << std::setprecision(10) << t_value;
+    return out.str();
+}
+
+std::string StatsReport::escapeJson(const std::string& t_text) {
+    std::ostringstream out;
+    for (char c : t_text) {
+        if (c == '"' || c == '\\') {
+            out << '\\' << c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            out << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(c) << std::dec;
+        } else {
+            out << c;
+        }
+    }
+    return out.str();
+}
+
+std::string StatsReport::escapeCsv(const std::string& t_text) {
+    if (t_text.find_first_of(",\"\n\r") == std::string::npos) {
+        return t_text;
+    }
+    std::string quoted = "\"";
+    for (char c : t_text) {
+        if (c == '"') quoted += '"';
+        quoted += c;
+    }
+    return quoted + "\"";
+}
@@ -0,0 +1,61 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <iostream>
+#include <type_traits>
+#include "../cache/cache.h"
+#include "../cli/arg_parser.h"
+#include "../memory/dram.h"
+#include "../threading/self_profile.h"
+
+// machine-readable record of one run: configuration, every counter of CacheStats, per-core cycles,
+// DRAM statistics and the simulator's own wall time and throughput. fields keep the order they are
+// added in and are grouped by section, which become objects in JSON and "section.name" columns of
+// a one-row CSV. sections only present for some options (sampling, DRAM, miss classes) are left out
+// when those options are off, so compare CSV files by column name rather than position
+class StatsReport {
+
+public:
+    void addRun(const ValidParams& t_params, double t_wall_seconds, uint64_t t_requests);
+    void addConfig(const ValidParams& t_params);
+    void addCacheStats(const CacheStats& t_stats);
+    void addDram(const DramStats& t_stats);
+    void addSelfProfile(const SelfProfile& t_profile);
+
+    void writeJson(std::ostream& t_out) const;
+    void writeCsv(std::ostream& t_out) const;
+
+    template <typename T>
+    void add(const std::string& t_section, const std::string& t_name, const T& t_value) {
+        Field field{t_section, t_name, "", false};
+        if constexpr (std::is_same_v<T, bool>) {
+            field.m_value = t_value ? "true" : "false";
+        } else if constexpr (std::is_integral_v<T>) {
+            field.m_value = std::to_string(t_value);
+        } else if constexpr (std::is_floating_point_v<T>) {
+            field.m_value = formatReal(t_value);
+        } else {
+            field.m_value = t_value;
+            field.m_text = true;
+        }
+        m_fields.push_back(std::move(field));
+    }
+
+    size_t size() const { return m_fields.size(); }
+
+private:
+    struct Field {
+        std::string m_section;
+        std::string m_name;
+        std::string m_value;
+        bool m_text; // quoted in JSON, numbers and booleans are written as they are
+    };
+
+    static std::string formatReal(double t_value);
+    static std::string escapeJson(const std::string& t_text);
+    static std::string escapeCsv(const std::string& t_text);
+    void addCounters(const std::string& t_prefix, const PerfSample& t_counters);
+
+    std::vector<Field> m_fields;
+};
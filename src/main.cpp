@@ -6,6 +6,9 @@
 #include "io/file_manager.h"
 #include "cache/cache.h"
 #include "threading/core_manager.h"
+#include "threading/core_hierarchy.h"
+#include "threading/sweep_runner.h"
+#include "io/stats_report.h"
 
 int getMemorySize(std::string& t_size) {
     if (t_size == "small") { 
@@ -17,31 +20,135 @@ int getMemorySize(std::string& t_size) {
     }
 }
 
-void handleSingleThread(ValidParams& params, Memory& memory, FileManager& fm, CacheStats* stats) {
-    Cache* L3_cache = new Cache(params.l3_cache_size, params.associativity, params.replacement_policy, params.write_policy, L3, nullptr, memory, stats, params.isVerbose);
-    Cache* L2_cache = new Cache(params.l2_cache_size, params.associativity, params.replacement_policy, params.write_policy, L2, L3_cache, memory, stats, params.isVerbose);
-    Cache* L1_cache = new Cache(params.l1_cache_size, params.associativity, params.replacement_policy, params.write_policy, L1, L2_cache, memory, stats, params.isVerbose, nullptr);
-    while (fm.getNumOperations() != 0) {
-        std::optional<MemoryRequest> opt_request = fm.getNextRequest();
-        if (opt_request.has_value()) {
-            MemoryRequest request = opt_request.value();
-            if (request.type == AccessType::READ) {
-                L1_cache->read(request.address);
+void handleSweep(ValidParams& params, FileManager& fm, int memory_size, SelfProfile* profile) {
+    std::vector<MemoryRequest> requests = fm.takeRequests(); // parsed once, shared by every point
+    SweepRunner runner(params, requests, memory_size);
+    auto t1 = std::chrono::high_resolution_clock::now();
+    std::vector<SweepResult> results;
+    {
+        ScopedPhase phase(profile, "simulation");
+        results = runner.run(params.sweep_jobs, params.sweep_lockstep_batch);
+    }
+    auto t2 = std::chrono::high_resolution_clock::now();
+    if (profile != nullptr) {
+        profile->setRequests(static_cast<uint64_t>(requests.size()) * results.size());
+    }
+    std::cout << "Sweep: " << results.size() << " configurations"
+              << (params.sweep_lockstep_batch > 0 ? " (lockstep)" : "") << ", time taken: "
+              << std::chrono::duration_cast<std::chrono::milliseconds>(t2-t1).count() << "ms" << std::endl;
+    if (params.sweep_output.empty()) {
+        SweepRunner::writeResults(results, std::cout);
+        return;
+    }
+    std::ofstream out(params.sweep_output);
+    if (!out.is_open()) {
+        throw CacheException("Failed to open sweep output file: " + params.sweep_output);
+    }
+    SweepRunner::writeResults(results, out);
+    std::cout << "Sweep results written to " << params.sweep_output << std::endl;
+}
+
+// writes the per-set heat map and the hot block rankings of every cache to the files asked for
+void writeSetProfiles(const ValidParams& params, const std::vector<std::pair<std::string, const Cache*>>& caches) {
+    if (!params.set_heatmap.empty()) {
+        std::ofstream out(params.set_heatmap);
+        if (!out.is_open()) {
+            throw CacheException("Failed to open set heat map file: " + params.set_heatmap);
+        }
+        SetProfiler::writeSetHeader(out);
+        for (const auto& [label, cache] : caches) {
+            cache->getSetProfiler()->writeSets(out, label);
+        }
+        std::cout << "Set heat map written to " << params.set_heatmap << std::endl;
+    }
+    if (!params.hot_blocks.empty()) {
+        std::ofstream out(params.hot_blocks);
+        if (!out.is_open()) {
+            throw CacheException("Failed to open hot blocks file: " + params.hot_blocks);
+        }
+        SetProfiler::writeHotBlockHeader(out);
+        for (const auto& [label, cache] : caches) {
+            cache->getSetProfiler()->writeHotBlocks(out, label);
+        }
+        std::cout << "Hot blocks written to " << params.hot_blocks << std::endl;
+    }
+}
+
+// machine-readable copies of the summary, for scripts that would otherwise scrape stdout
+void writeStatsReports(const ValidParams& params, const CacheStats& stats, const Memory& memory, double wall_seconds,
+                       const SelfProfile* profile) {
+    if (params.stats_json.empty() && params.stats_csv.empty()) {
+        return;
+    }
+    StatsReport report;
+    report.addRun(params, wall_seconds, stats.simulatedRequests());
+    report.addConfig(params);
+    report.addCacheStats(stats);
+    if (memory.hasDram()) {
+        report.addDram(memory.getDram()->getStats());
+    }
+    if (profile != nullptr) {
+        report.addSelfProfile(*profile);
+    }
+    auto open = [](const std::string& path) {
+        std::ofstream out(path);
+        if (!out.is_open()) {
+            throw CacheException("Failed to open statistics file: " + path);
+        }
+        return out;
+    };
+    if (!params.stats_json.empty()) {
+        std::ofstream out = open(params.stats_json);
+        report.writeJson(out);
+        std::cout << "Statistics written to " << params.stats_json << std::endl;
+    }
+    if (!params.stats_csv.empty()) {
+        std::ofstream out = open(params.stats_csv);
+        report.writeCsv(out);
+        std::cout << "Statistics written to " << params.stats_csv << std::endl;
+    }
+}
+
+void handleSingleThread(ValidParams& params, Memory& memory, FileManager& fm, CacheStats* stats, ReuseProfiler* reuse,
+                        SelfProfile* profile) {
+    std::unique_ptr<IntervalLog> intervals;
+    if (!params.interval_log.empty()) {
+        intervals = std::make_unique<IntervalLog>(params.interval_log, params.interval_requests, params.interval_cycles);
+    }
+    CoreHierarchy hierarchy(params, memory, stats);
+    hierarchy.attachReuseProfiler(reuse);
+    hierarchy.attachIntervalLog(intervals.get());
+    uint64_t trace_position = 0;
+    if (!params.checkpoint_restore.empty()) {
+        trace_position = hierarchy.restoreCheckpoint(params.checkpoint_restore);
+        fm.skipRequests(trace_position);
+        std::cout << "Restored checkpoint " << params.checkpoint_restore << " at request " << trace_position << std::endl;
+    }
+    uint64_t save_at = static_cast<uint64_t>(params.checkpoint_at);
+    if (save_at != 0 && save_at < trace_position) {
+        throw CacheException("Checkpoint position " + std::to_string(save_at) + " is before the restored position.");
+    }
+    {
+        ScopedPhase phase(profile, "simulation");
+        while (fm.getNumOperations() != 0 && (save_at == 0 || trace_position < save_at)) {
+            std::optional<MemoryRequest> opt_request = fm.getNextRequest();
+            if (opt_request.has_value()) {
+                hierarchy.access(opt_request.value());
+                trace_position++;
             } else {
-                L1_cache->write(request.address, request.value);
+                throw CacheException("Error retrieving next memory request.");
             }
-        } else {
-            throw CacheException("Error retrieving next memory request.");
         }
     }
-    if (params.write_policy == "WB") {
-        L1_cache->flushCache();
-        L2_cache->flushCache();
-        L3_cache->flushCache();
+    if (!params.checkpoint_save.empty()) {
+        hierarchy.saveCheckpoint(params.checkpoint_save, trace_position);
+        std::cout << "Checkpoint written to " << params.checkpoint_save << " at request " << trace_position << std::endl;
     }
-    delete L1_cache;
-    delete L2_cache;
-    delete L3_cache;
+    {
+        ScopedPhase phase(profile, "flush");
+        hierarchy.finish();
+    }
+    writeSetProfiles(params, hierarchy.labelledCaches());
 }
 
 int main(int argc, char *argv[]) {
@@ -52,29 +159,53 @@ int main(int argc, char *argv[]) {
             ValidParams params = argParser.getValidParams();
 
             int memory_size_bytes = getMemorySize(params.memory_size);
-            Memory memory(memory_size_bytes, params.isVerbose);
-            std::cout << "L1 Cache Size: " << (params.l1_cache_size / 1024) << " MB" <<std::endl;
-            std::cout << "L2 Cache Size: " << (params.l2_cache_size / 1024) << " MB" <<std::endl;
-            std::cout << "L3 Cache Size: " << (params.l3_cache_size / 1024) << " MB" <<std::endl;
+            Memory memory(memory_size_bytes, params.isVerbose, params.full_address_space);
+            if (params.dram_enabled) {
+                memory.attachDram(params.dram);
+            }
+            std::cout << "L1 Cache Size: " << (params.l1_cache_size / 1024) << " KB" <<std::endl;
+            std::cout << "L2 Cache Size: " << (params.l2_cache_size / 1024) << " KB" <<std::endl;
+            std::cout << "L3 Cache Size: " << (params.l3_cache_size / 1024) << " KB" <<std::endl;
             FileManager fm(params.access_file_name, params.isVerbose);
             if (fm.isValidFile()) {
-                fm.parseFile();
+                std::unique_ptr<SelfProfile> profile;
+                if (params.self_profile) profile = std::make_unique<SelfProfile>();
+                if (params.perf_counters) profile->enablePerfCounters();
+                {
+                    ScopedPhase phase(profile.get(), "parse");
+                    fm.parseFile();
+                }
                 CacheStats stats;
-                if (params.num_threads == 1) {
+                if (params.sweep_enabled) {
+                    handleSweep(params, fm, memory_size_bytes, profile.get());
+                } else if (params.num_threads == 1) {
+                    std::unique_ptr<ReuseProfiler> reuse;
+                    if (params.reuse_distance) reuse = std::make_unique<ReuseProfiler>(params.l1_block_size);
                     auto t1 = std::chrono::high_resolution_clock::now();
-                    handleSingleThread(params, memory, fm, &stats);
+                    handleSingleThread(params, memory, fm, &stats, reuse.get(), profile.get());
                     auto t2 = std::chrono::high_resolution_clock::now();
                     std::cout << "time taken: " << std::chrono::duration_cast<std::chrono::milliseconds>(t2-t1).count() << "ms" << std::endl;
                     stats.printSummary();
+                    if (memory.hasDram()) memory.getDram()->printSummary();
+                    if (reuse != nullptr) reuse->printSummary("trace");
+                    if (profile != nullptr) profile->setRequests(stats.simulatedRequests());
+                    writeStatsReports(params, stats, memory, std::chrono::duration<double>(t2 - t1).count(), profile.get());
                 } else {
                     CoreManager* core_manager = new CoreManager(params.num_threads, &params, &fm, memory, params.isVerbose, &stats);
+                    core_manager->attachSelfProfile(profile.get());
                     auto t1 = std::chrono::high_resolution_clock::now();
                     core_manager->startSimulation();
                     auto t2 = std::chrono::high_resolution_clock::now();
                     std::cout << "time taken: " << std::chrono::duration_cast<std::chrono::milliseconds>(t2-t1).count() << "ms" << std::endl;
                     stats.printSummary();
+                    if (memory.hasDram()) memory.getDram()->printSummary();
+                    core_manager->printReuseSummary();
+                    writeSetProfiles(params, core_manager->labelledCaches());
+                    if (profile != nullptr) profile->setRequests(stats.simulatedRequests());
+                    writeStatsReports(params, stats, memory, std::chrono::duration<double>(t2 - t1).count(), profile.get());
                     delete core_manager;
                 }
+                if (profile != nullptr) profile->printSummary();
             } else {
                 std::cout << "Invalid file - Not a .txt extension or located in examples/" << std::endl;
             }
@@ -0,0 +1,100 @@
+#include "dram.h"
+#include <algorithm>
+
+DramModel::DramModel(const DramConfig& t_config) : m_config(t_config) {
+    if (m_config.channels <= 0 || m_config.ranks <= 0 || m_config.banks <= 0) {
+        throw CacheException("DRAM channels, ranks and banks must be positive.");
+    }
+    if (m_config.row_size < ACCESS_BYTES || m_config.row_size % ACCESS_BYTES != 0) {
+        throw CacheException("DRAM row size must be a multiple of the block size.");
+    }
+    if (m_config.row_policy != "OPEN" && m_config.row_policy != "CLOSED") {
+        throw CacheException("Invalid DRAM row policy: " + m_config.row_policy);
+    }
+    if (m_config.t_rcd < 0 || m_config.t_cas < 0 || m_config.t_rp < 0 || m_config.t_controller < 0) {
+        throw CacheException("DRAM timings must be non-negative.");
+    }
+    m_blocks_per_row = m_config.row_size / ACCESS_BYTES;
+    m_open_page = m_config.row_policy == "OPEN";
+    int num_banks = m_config.channels * m_config.ranks * m_config.banks;
+    m_open_rows.assign(num_banks, -1);
+    m_bank_conflicts.assign(num_banks, 0);
+}
+
+DramAddress DramModel::decode(uint64_t t_address) const {
+    uint64_t block = t_address / ACCESS_BYTES;
+    DramAddress address;
+    address.channel = static_cast<int>(block % m_config.channels);
+    block /= m_config.channels;
+    address.column = static_cast<int>(block % m_blocks_per_row);
+    block /= m_blocks_per_row;
+    address.bank = static_cast<int>(block % m_config.banks);
+    block /= m_config.banks;
+    address.rank = static_cast<int>(block % m_config.ranks);
+    address.row = static_cast<int64_t>(block / m_config.ranks);
+    return address;
+}
+
+int DramModel::bankSlot(const DramAddress& t_address) const {
+    return (t_address.channel * m_config.ranks + t_address.rank) * m_config.banks + t_address.bank;
+}
+
+// returns the cycles taken by the request
+uint64_t DramModel::access(uint64_t t_address, bool t_isWrite) {
+    DramAddress address = decode(t_address);
+    int slot = bankSlot(address);
+    int64_t& open_row = m_open_rows[slot];
+
+    uint64_t cycles = m_config.t_controller;
+    if (open_row == address.row) {
+        cycles += m_config.t_cas;
+        m_stats.row_hits++;
+    } else if (open_row == -1) {
+        cycles += m_config.t_rcd + m_config.t_cas;
+        m_stats.row_empty++;
+    } else {
+        cycles += m_config.t_rp + m_config.t_rcd + m_config.t_cas;
+        m_stats.row_conflicts++;
+        m_bank_conflicts[slot]++;
+    }
+    // closed page precharges right after the access, off the critical path
+    open_row = m_open_page ? address.row : -1;
+
+    if (t_isWrite) {
+        m_stats.writes++;
+    } else {
+        m_stats.reads++;
+    }
+    m_stats.total_cycles += cycles;
+    return cycles;
+}
+
+void DramModel::printSummary() const {
+    std::cout << "\n===== DRAM Summary =====\n";
+    std::cout << "Organization: " << m_config.channels << " channel(s), " << m_config.ranks << " rank(s), "
+              << m_config.banks << " bank(s), " << m_config.row_size << "B rows, " << m_config.row_policy << " page\n";
+    std::cout << "Reads: " << m_stats.reads << "\n";
+    std::cout << "Writes: " << m_stats.writes << "\n";
+    std::cout << "Row Buffer Hits: " << m_stats.row_hits << " (" << m_stats.rowHitRate() << "%)\n";
+    std::cout << "Row Buffer Empty: " << m_stats.row_empty << "\n";
+    std::cout << "Row Buffer Conflicts: " << m_stats.row_conflicts << "\n";
+    std::cout << "Average DRAM Latency: " << m_stats.averageLatency() << " cycles\n";
+
+    // report the bank that suffers the most conflicts, a sign of poor interleaving
+    size_t worst = 0;
+    for (size_t slot = 1; slot < m_bank_conflicts.size(); slot++) {
+        if (m_bank_conflicts[slot] > m_bank_conflicts[worst]) worst = slot;
+    }
+    if (!m_bank_conflicts.empty() && m_bank_conflicts[worst] > 0) {
+        std::cout << "Most Conflicted Bank: channel " << worst / (m_config.ranks * m_config.banks)
+                  << ", rank " << (worst / m_config.banks) % m_config.ranks
+                  << ", bank " << worst % m_config.banks
+                  << " (" << m_bank_conflicts[worst] << " conflicts)\n";
+    }
+    std::cout << "========================\n";
+}
+
+void DramModel::resetStats() {
+    m_stats = DramStats();
+    std::fill(m_bank_conflicts.begin(), m_bank_conflicts.end(), 0);
+}
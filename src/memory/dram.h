@@ -0,0 +1,75 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <iostream>
+#include "../exception/cache_exception.h"
+
+// timings are given directly in simulated CPU cycles
+struct DramConfig {
+    int channels = 1;
+    int ranks = 1;
+    int banks = 8;
+    int row_size = 8192; // bytes per row in one bank
+    std::string row_policy = "OPEN"; // OPEN keeps the row buffer open, CLOSED precharges after every access
+    int t_rcd = 42; // activate -> column command
+    int t_cas = 42; // column command -> data
+    int t_rp = 42;  // precharge
+    int t_controller = 40; // queueing, command bus and data transfer overhead per request
+};
+
+struct DramStats {
+    uint64_t reads = 0;
+    uint64_t writes = 0;
+    uint64_t row_hits = 0;      // row already open in the bank
+    uint64_t row_empty = 0;     // bank precharged, activate needed
+    uint64_t row_conflicts = 0; // different row open in the bank, precharge + activate needed
+    uint64_t total_cycles = 0;
+
+    double rowHitRate() const {
+        uint64_t total = reads + writes;
+        return total == 0 ? 0.0 : 100.0 * row_hits / total;
+    }
+
+    double averageLatency() const {
+        uint64_t total = reads + writes;
+        return total == 0 ? 0.0 : static_cast<double>(total_cycles) / total;
+    }
+};
+
+struct DramAddress {
+    int channel;
+    int rank;
+    int bank;
+    int64_t row;
+    int column;
+};
+
+// row buffer timing model placed behind Memory. each request is one cache block; the block
+// address is split as [row | rank | bank | column | channel] so consecutive blocks
+// interleave across channels and then stay in the same row
+class DramModel {
+
+public:
+    static constexpr int ACCESS_BYTES = 64; // one cache block per request
+
+    explicit DramModel(const DramConfig& t_config);
+
+    uint64_t access(uint64_t t_address, bool t_isWrite);
+    DramAddress decode(uint64_t t_address) const;
+    const DramStats& getStats() const { return m_stats; }
+    const DramConfig& getConfig() const { return m_config; }
+    const std::vector<uint64_t>& getBankConflicts() const { return m_bank_conflicts; }
+    void printSummary() const;
+    void resetStats(); // keeps the open rows, only the counters start over
+
+private:
+    int bankSlot(const DramAddress& t_address) const;
+
+    DramConfig m_config;
+    int m_blocks_per_row;
+    bool m_open_page;
+    std::vector<int64_t> m_open_rows; // per (channel, rank, bank), -1 = precharged
+    std::vector<uint64_t> m_bank_conflicts;
+    DramStats m_stats;
+};
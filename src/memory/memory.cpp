@@ -1,6 +1,11 @@
 #include "memory.h"
+#include <algorithm>
 
-Memory::Memory(int memory_size, bool isVerbose) : m_memory_size(memory_size), endAddress(baseAddress + memory_size - 4), m_isVerbose(isVerbose) {
+Memory::Memory(int memory_size, bool isVerbose, bool fullAddressSpace) 
+    : baseAddress(fullAddressSpace ? 0 : 0x1000),
+    m_memory_size(memory_size),
+    endAddress(fullAddressSpace ? UINT64_MAX - 3 : baseAddress + memory_size - 4),
+    m_isVerbose(isVerbose) {
     std::cout << "MEMORY Initialized | Range: 0x" << std::hex << baseAddress 
               << " - 0x" << endAddress 
               << " | Size: " << std::dec << memory_size / (1024 * 1024) << " MB" << std::endl;
@@ -10,18 +15,19 @@ Memory::~Memory() {
     m_memory.clear();
 }
 
-int Memory::read(uint32_t address) {
+int Memory::read(uint64_t address) {
     if (!isValidAddress(address)) {
         throw CacheException("Invalid address reading from memory");
     }
-    int value = m_memory.count(address) ? m_memory.at(address) : 0;
+    auto word = m_memory.find(address); // one hash lookup, every block fill reads a word per call
+    int value = (word != m_memory.end()) ? word->second : 0;
     if (m_isVerbose) {
         std::cout << "[MEMORY] Reading value " << value << " from address 0x" << std::hex << address << std::dec << "\n";
     }
-    return m_memory.count(address) ? m_memory.at(address) : 0;
+    return value;
 }
 
-void Memory::write(uint32_t address, int value) {
+void Memory::write(uint64_t address, int value) {
     if (!isValidAddress(address)) {
         throw CacheException("Invalid address writing to memory");
     }
@@ -31,6 +37,25 @@ void Memory::write(uint32_t address, int value) {
     m_memory[address] = value;
 }
 
+void Memory::attachDram(const DramConfig& config) {
+    m_dram = std::make_unique<DramModel>(config);
+}
+
+// times one block sized request against the DRAM model, returns the cycles it took
+uint64_t Memory::accessDram(uint64_t address, bool isWrite) {
+    if (m_dram == nullptr) {
+        throw CacheException("No DRAM model attached to memory");
+    }
+    uint64_t cycles = m_dram->access(address, isWrite);
+    if (m_isVerbose) {
+        DramAddress location = m_dram->decode(address);
+        std::cout << "[DRAM] " << (isWrite ? "Write" : "Read") << " 0x" << std::hex << address << std::dec
+                  << " | Channel: " << location.channel << " | Rank: " << location.rank << " | Bank: " << location.bank
+                  << " | Row: " << location.row << " | Cycles: " << cycles << "\n";
+    }
+    return cycles;
+}
+
 void Memory::printMemoryState() {
     std::cout << "[MEMORY] State:\n";
     for (const auto& pair : m_memory) {
@@ -39,7 +64,32 @@ void Memory::printMemoryState() {
     }
 }
 
-bool Memory::isValidAddress(uint32_t address) const {
+// only non-zero words are stored, every other word reads back as zero
+void Memory::saveState(std::ostream& t_out) const {
+    uint64_t count = std::count_if(m_memory.begin(), m_memory.end(), [](const auto& word) { return word.second != 0; });
+    binary_io::write<uint64_t>(t_out, count);
+    for (const auto& word : m_memory) {
+        if (word.second == 0) continue;
+        binary_io::write<uint64_t>(t_out, word.first);
+        binary_io::write<int32_t>(t_out, word.second);
+    }
+}
+
+void Memory::restoreState(std::istream& t_in) {
+    uint64_t count = binary_io::read<uint64_t>(t_in);
+    m_memory.clear();
+    m_memory.reserve(count);
+    for (uint64_t i = 0; i < count; i++) {
+        uint64_t address = binary_io::read<uint64_t>(t_in);
+        int value = binary_io::read<int32_t>(t_in);
+        if (!isValidAddress(address)) {
+            throw CacheException("Checkpoint memory does not fit the configured memory range.");
+        }
+        m_memory[address] = value;
+    }
+}
+
+bool Memory::isValidAddress(uint64_t address) const {
     if (address % 4 != 0) {
         if (m_isVerbose) std::cerr << "[ERROR] Unaligned memory access at 0x" << std::hex << address << std::dec << "\n";
         return false;
@@ -2,23 +2,37 @@
 #include <unordered_map>
 #include <cstdint>
 #include <iostream>
+#include <memory>
 #include "../exception/cache_exception.h"
+#include "dram.h"
+#include "../io/binary_io.h"
 
 class Memory {
 public:
-    Memory(int memory_size, bool isVerbose);
+    Memory(int memory_size, bool isVerbose, bool fullAddressSpace = false);
     ~Memory();
     
-    int read(uint32_t address);
-    void write(uint32_t address, int value);
+    int read(uint64_t address);
+    void write(uint64_t address, int value);
     void printMemoryState();  // for debugging
+    void saveState(std::ostream& t_out) const;
+    void restoreState(std::istream& t_in);
+    bool inRange(uint64_t address) const { return address >= baseAddress && address <= endAddress; }
+
+    // optional timing model, the functional store is unaffected
+    void attachDram(const DramConfig& config);
+    bool hasDram() const { return m_dram != nullptr; }
+    uint64_t accessDram(uint64_t address, bool isWrite);
+    const DramModel* getDram() const { return m_dram.get(); }
+    void resetDramStats() { if (m_dram != nullptr) m_dram->resetStats(); }
 
 private:
-    bool isValidAddress(uint32_t address) const;
+    bool isValidAddress(uint64_t address) const;
 
-    const uint32_t baseAddress = 0x1000;
-    std::unordered_map<uint32_t, int> m_memory; 
+    const uint64_t baseAddress;
+    std::unordered_map<uint64_t, int> m_memory; // sparse, only written words are stored
     int m_memory_size; // value in bytes
-    const uint32_t endAddress;
+    const uint64_t endAddress; // full address space: every aligned 64-bit address is valid
     bool m_isVerbose;
+    std::unique_ptr<DramModel> m_dram;
 };
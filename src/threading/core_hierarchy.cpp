@@ -0,0 +1,171 @@
+#include "core_hierarchy.h"
+#include "core_manager.h"
+#include <fstream>
+
+CoreHierarchy::CoreHierarchy(const ValidParams& t_params, Memory& t_memory, CacheStats* t_stats) : m_memory(t_memory), m_stats(t_stats) {
+    m_l3 = std::make_unique<Cache>(t_params.l3_cache_size, t_params.l3_associativity, t_params.l3_replacement_policy, t_params.l3_write_policy,
+        L3, nullptr, t_memory, t_stats, t_params.isVerbose, nullptr, t_params.l3_block_size);
+    m_l2 = std::make_unique<Cache>(t_params.l2_cache_size, t_params.l2_associativity, t_params.l2_replacement_policy, t_params.l2_write_policy,
+        L2, m_l3.get(), t_memory, t_stats, t_params.isVerbose, nullptr, t_params.l2_block_size);
+    m_l1 = std::make_unique<Cache>(t_params.l1_cache_size, t_params.l1_associativity, t_params.l1_replacement_policy, t_params.l1_write_policy,
+        L1, m_l2.get(), t_memory, t_stats, t_params.isVerbose, nullptr, t_params.l1_block_size);
+    CoreManager::configureLevel(m_l1.get(), L1, t_params);
+    CoreManager::configureLevel(m_l2.get(), L2, t_params);
+    CoreManager::configureLevel(m_l3.get(), L3, t_params);
+    if (t_params.time_sample_period > 0) {
+        setTimeSampling(t_params.time_sample_period, t_params.time_sample_unit);
+    }
+    m_warmup_remaining = t_params.warmup_requests;
+}
+
+// SMARTS-style systematic sampling: functional warming keeps the tag state current between
+// detailed units, and the per-unit rates give the sampled estimate and its error bound
+void CoreHierarchy::setTimeSampling(int t_period, int t_unit) {
+    if (t_period <= 0 || t_unit <= 0 || t_unit > t_period) {
+        throw CacheException("Time sampling needs 0 < unit <= period.");
+    }
+    m_sample_period = t_period;
+    m_sample_unit = t_unit;
+    m_stats->time_sample_period = t_period;
+}
+
+void CoreHierarchy::access(const MemoryRequest& t_request) {
+    if (m_reuse != nullptr) {
+        m_reuse->record(t_request.address);
+    }
+    if (m_intervals != nullptr) {
+        m_intervals->observe(*m_stats);
+    }
+    if (m_warmup_remaining > 0) {
+        m_stats->warmup_requests++;
+        detailedAccess(t_request);
+        if (--m_warmup_remaining == 0) {
+            endWarmup();
+        }
+        return;
+    }
+    if (m_sample_period == 0) {
+        detailedAccess(t_request);
+        return;
+    }
+    uint64_t position = m_requests_seen++ % m_sample_period;
+    if (position < m_sample_period - m_sample_unit) {
+        m_l1->warm(t_request.address, t_request.type == AccessType::WRITE, t_request.value);
+        m_stats->warmed_requests++;
+        return;
+    }
+    if (position == m_sample_period - m_sample_unit) {
+        beginUnit();
+    }
+    detailedAccess(t_request);
+    if (position == m_sample_period - 1) {
+        endUnit();
+    }
+}
+
+void CoreHierarchy::detailedAccess(const MemoryRequest& t_request) {
+    if (t_request.type == AccessType::READ) {
+        m_l1->read(t_request.address);
+    } else {
+        m_l1->write(t_request.address, t_request.value);
+    }
+}
+
+void CoreHierarchy::beginUnit() {
+    m_unit_start.operations = m_stats->total_operations;
+    m_unit_start.cycles = m_l1->getTotalCycles();
+    m_unit_start.l1_misses = m_stats->l1_misses;
+    m_unit_start.l2_misses = m_stats->l2_misses;
+    m_unit_start.l3_misses = m_stats->l3_misses;
+    m_unit_open = true;
+}
+
+void CoreHierarchy::endUnit() {
+    SampleUnit unit;
+    unit.operations = m_stats->total_operations - m_unit_start.operations;
+    unit.cycles = m_l1->getTotalCycles() - m_unit_start.cycles;
+    unit.l1_misses = m_stats->l1_misses - m_unit_start.l1_misses;
+    unit.l2_misses = m_stats->l2_misses - m_unit_start.l2_misses;
+    unit.l3_misses = m_stats->l3_misses - m_unit_start.l3_misses;
+    m_stats->sample_units.push_back(unit);
+    m_unit_open = false;
+}
+
+// the warm-up runs in detail so timing state is warm too; only the counters start over.
+// time sampling starts its first period after the warm-up
+void CoreHierarchy::endWarmup() {
+    if (m_intervals != nullptr) {
+        m_intervals->markCountersReset(*m_stats);
+    }
+    m_stats->resetCounters();
+    m_memory.resetDramStats();
+    if (m_reuse != nullptr) {
+        m_reuse->resetCounts();
+    }
+    m_l1->resetSetProfile();
+    m_l2->resetSetProfile();
+    m_l3->resetSetProfile();
+    m_warmup_cycles = m_l1->getTotalCycles();
+}
+
+std::vector<std::pair<std::string, const Cache*>> CoreHierarchy::labelledCaches() const {
+    return {{"L1.0", m_l1.get()}, {"L2.0", m_l2.get()}, {"L3.0", m_l3.get()}};
+}
+
+// levels may mix write policies, flushing a write-through level only drains its write buffer
+void CoreHierarchy::finish() {
+    if (m_warmup_remaining > 0) {
+        m_warmup_remaining = 0;
+        endWarmup(); // trace ended inside the warm-up, nothing is measured
+    }
+    if (m_unit_open) {
+        endUnit(); // trace ended inside a unit
+    }
+    if (m_intervals != nullptr) {
+        m_intervals->finish(*m_stats);
+    }
+    m_stats->core_cycles.push_back(m_l1->getTotalCycles() - m_warmup_cycles);
+    m_l1->flushCache();
+    m_l2->flushCache();
+    m_l3->flushCache();
+}
+
+// binary snapshot of the warmed hierarchy: memory words, every level's lines and the trace
+// position. statistics are not saved, a restored run reports only what happens after it.
+// write buffers drain first so no store is held outside the saved lines and memory
+void CoreHierarchy::saveCheckpoint(const std::string& t_path, uint64_t t_trace_position) {
+    m_l1->drainWriteBuffer();
+    m_l2->drainWriteBuffer();
+    m_l3->drainWriteBuffer();
+    std::ofstream out(t_path, std::ios::binary);
+    if (!out.is_open()) {
+        throw CacheException("Failed to open checkpoint file: " + t_path);
+    }
+    binary_io::write<uint64_t>(out, CHECKPOINT_MAGIC);
+    binary_io::write<uint32_t>(out, CHECKPOINT_VERSION);
+    binary_io::write<uint64_t>(out, t_trace_position);
+    m_memory.saveState(out);
+    m_l1->saveState(out);
+    m_l2->saveState(out);
+    m_l3->saveState(out);
+    if (!out) {
+        throw CacheException("Failed to write checkpoint file: " + t_path);
+    }
+}
+
+// memory is restored first, victims that no longer fit are written back on top of it
+uint64_t CoreHierarchy::restoreCheckpoint(const std::string& t_path) {
+    std::ifstream in(t_path, std::ios::binary);
+    if (!in.is_open()) {
+        throw CacheException("Failed to open checkpoint file: " + t_path);
+    }
+    if (binary_io::read<uint64_t>(in) != CHECKPOINT_MAGIC || binary_io::read<uint32_t>(in) != CHECKPOINT_VERSION) {
+        throw CacheException("Not a checkpoint file or unsupported version: " + t_path);
+    }
+    uint64_t trace_position = binary_io::read<uint64_t>(in);
+    m_memory.restoreState(in);
+    m_l1->restoreState(in);
+    m_l2->restoreState(in);
+    m_l3->restoreState(in);
+    return trace_position;
+}
@@ -0,0 +1,55 @@
+#pragma once
+#include <memory>
+#include "../cache/cache.h"
+#include "../cache/reuse_profiler.h"
+#include "../io/interval_log.h"
+#include "../cli/arg_parser.h"
+#include "../io/file_manager.h"
+#include "../memory/memory.h"
+
+// one core's private L1 -> L2 -> L3 chain, built and configured from ValidParams.
+// used by the single-thread run and by the sweep, which owns one per configuration
+class CoreHierarchy {
+
+public:
+    CoreHierarchy(const ValidParams& t_params, Memory& t_memory, CacheStats* t_stats);
+
+    void access(const MemoryRequest& t_request);
+    void finish(); // records the core's cycles and flushes every level to memory
+    void setTimeSampling(int t_period, int t_unit);
+    void attachReuseProfiler(ReuseProfiler* t_profiler) { m_reuse = t_profiler; }
+    void attachIntervalLog(IntervalLog* t_log) { m_intervals = t_log; }
+    void saveCheckpoint(const std::string& t_path, uint64_t t_trace_position);
+    uint64_t restoreCheckpoint(const std::string& t_path); // returns the trace position to resume from
+
+    Cache* getL1() const { return m_l1.get(); }
+    Cache* getL2() const { return m_l2.get(); }
+    Cache* getL3() const { return m_l3.get(); }
+    std::vector<std::pair<std::string, const Cache*>> labelledCaches() const; // "L1.0", "L2.0", "L3.0"
+
+private:
+    void detailedAccess(const MemoryRequest& t_request);
+    void endWarmup();
+    void beginUnit();
+    void endUnit();
+
+    static constexpr uint64_t CHECKPOINT_MAGIC = 0x54504B434D495350ULL; // "PSIMCKPT"
+    static constexpr uint32_t CHECKPOINT_VERSION = 1;
+
+    Memory& m_memory;
+    CacheStats* m_stats;
+    uint64_t m_warmup_remaining = 0; // requests still run before the counters are reset
+    uint64_t m_warmup_cycles = 0; // core cycles at the end of the warm-up
+    ReuseProfiler* m_reuse = nullptr; // optional, sees every request including warm-up and warming
+    IntervalLog* m_intervals = nullptr; // optional, counts every request including warm-up and warming
+    // time sampling: the last m_sample_unit requests of every m_sample_period run in detail
+    uint64_t m_sample_period = 0;
+    uint64_t m_sample_unit = 0;
+    uint64_t m_requests_seen = 0;
+    SampleUnit m_unit_start;
+    bool m_unit_open = false;
+    // declared bottom up so the upper levels are destroyed first
+    std::unique_ptr<Cache> m_l3;
+    std::unique_ptr<Cache> m_l2;
+    std::unique_ptr<Cache> m_l1;
+};
@@ -9,7 +9,8 @@ CoreManager::CoreManager(int t_num_threads, ValidParams* t_params, FileManager*
 
     L3_caches.resize(std::max((num_threads + 3) / 4, 1), nullptr);
     for (size_t i = 0; i < L3_caches.size(); i++) {
-        L3_caches[i] = new Cache(params->l3_cache_size, params->associativity, params->replacement_policy, params->write_policy, L3, nullptr, memory, m_stats, params->isVerbose, nullptr);
+        L3_caches[i] = new Cache(params->l3_cache_size, params->l3_associativity, params->l3_replacement_policy, params->l3_write_policy, L3, nullptr, memory, m_stats, params->isVerbose, nullptr, params->l3_block_size);
+        configureLevel(L3_caches[i], L3, *params);
     }
     if (isVerbose) {
         std::cout << "[Core Manager] Initialized " << L3_caches.size() << " L3 Caches" << std::endl;
@@ -20,7 +21,8 @@ CoreManager::CoreManager(int t_num_threads, ValidParams* t_params, FileManager*
         if (l3_index >= L3_caches.size()) {
             throw std::runtime_error("CoreManager: L3 cache index out of bounds.");
         }
-        L2_caches[j] = new Cache(params->l2_cache_size, params->associativity, params->replacement_policy, params->write_policy, L2, L3_caches[j/2], memory, m_stats, params->isVerbose, nullptr);
+        L2_caches[j] = new Cache(params->l2_cache_size, params->l2_associativity, params->l2_replacement_policy, params->l2_write_policy, L2, L3_caches[j/2], memory, m_stats, params->isVerbose, nullptr, params->l2_block_size);
+        configureLevel(L2_caches[j], L2, *params);
     }
     if (isVerbose) {
         std::cout << "[Core Manager] Initialized " << L2_caches.size() << " L2 Caches" << std::endl;
@@ -31,11 +33,66 @@ CoreManager::CoreManager(int t_num_threads, ValidParams* t_params, FileManager*
         if (l2_index >= L2_caches.size()) {
             throw std::runtime_error("CoreManager: L2 cache index out of bounds.");
         }
-        L1_caches[k] = new Cache(params->l1_cache_size, params->associativity, params->replacement_policy, params->write_policy, L1, L2_caches[k/2], memory, m_stats, params->isVerbose, this);
+        L1_caches[k] = new Cache(params->l1_cache_size, params->l1_associativity, params->l1_replacement_policy, params->l1_write_policy, L1, L2_caches[k/2], memory, m_stats, params->isVerbose, this, params->l1_block_size);
+        configureLevel(L1_caches[k], L1, *params);
     }
     if (isVerbose) {
         std::cout << "[Core Manager] Initialized " << L1_caches.size() << " L1 Caches" << std::endl;
     }
+    if (params->reuse_distance) {
+        m_reuse_total = std::make_unique<ReuseProfiler>(params->l1_block_size);
+        for (int core = 0; core < num_threads; core++) {
+            m_reuse_per_core.push_back(std::make_unique<ReuseProfiler>(params->l1_block_size));
+        }
+    }
+    if (!params->interval_log.empty()) {
+        m_intervals = std::make_unique<IntervalLog>(params->interval_log, params->interval_requests, params->interval_cycles);
+    }
+}
+
+// applies the optional per-level settings from the command line to a freshly built cache
+void CoreManager::configureLevel(Cache* t_cache, Level t_level, const ValidParams& t_params) {
+    int hit_latency = (t_level == L1) ? t_params.l1_latency : (t_level == L2) ? t_params.l2_latency : t_params.l3_latency;
+    t_cache->setLatency(hit_latency, t_params.memory_latency, t_params.writeback_latency);
+    t_cache->setWriteAllocate(t_params.write_allocate);
+    int mshrs = (t_level == L1) ? t_params.l1_mshrs : (t_level == L2) ? t_params.l2_mshrs : t_params.l3_mshrs;
+    if (mshrs > 0) {
+        t_cache->attachMshrs(mshrs);
+    }
+    if (t_params.write_buffer_entries > 0 && t_cache->getWritePolicy() == "WT") {
+        t_cache->attachWriteBuffer(t_params.write_buffer_entries, t_params.write_buffer_drain);
+    }
+
+    if (t_level == L1) {
+        if (t_params.sample_all_levels && t_params.l3_set_sampling > 1) {
+            t_cache->enableSampleFilter();
+        }
+        if (t_params.victim_cache_entries > 0) {
+            t_cache->attachVictimCache(t_params.victim_cache_entries);
+        }
+        if (t_params.l1_prefetcher != "NONE") {
+            t_cache->attachPrefetcher(t_params.l1_prefetcher, t_params.prefetch_degree);
+        }
+    } else if (t_level == L2) {
+        t_cache->setInclusionPolicy(t_params.l2_inclusion_policy);
+        if (t_params.l2_prefetcher != "NONE") {
+            t_cache->attachPrefetcher(t_params.l2_prefetcher, t_params.prefetch_degree);
+        }
+    } else {
+        t_cache->setInclusionPolicy(t_params.l3_inclusion_policy);
+        if (t_params.l3_set_sampling > 1) {
+            t_cache->setSetSampling(t_params.l3_set_sampling);
+        }
+        if (t_params.l3_prefetcher != "NONE") {
+            t_cache->attachPrefetcher(t_params.l3_prefetcher, t_params.prefetch_degree);
+        }
+    }
+    if (t_params.classify_misses) {
+        t_cache->enableMissClassification();
+    }
+    if (!t_params.set_heatmap.empty() || !t_params.hot_blocks.empty()) {
+        t_cache->attachSetProfiler(t_params.hot_blocks.empty() ? 0 : t_params.top_k); // rankings only when written
+    }
 }
 
 CoreManager::~CoreManager() {
@@ -48,7 +105,43 @@ CoreManager::~CoreManager() {
     L3_caches.clear();
 }
 
+// the warm-up is its own phase: every worker stops once the first requests are taken, the
+// counters are reset while no access is in flight, and the workers restart on the rest
 void CoreManager::startSimulation() {
+    m_warmup_cycles.assign(L1_caches.size(), 0);
+    {
+        ScopedPhase phase(m_profile, "simulation");
+        if (params->warmup_requests > 0) {
+            runWorkers(params->warmup_requests);
+            endWarmup();
+        }
+        runWorkers(UINT64_MAX);
+        if (m_intervals != nullptr) {
+            m_intervals->finish(*m_stats);
+        }
+    }
+
+    for (size_t k = 0; k < L1_caches.size(); k++) {
+        m_stats->core_cycles.push_back(L1_caches[k]->getTotalCycles() - m_warmup_cycles[k]);
+    }
+
+    ScopedPhase phase(m_profile, "flush");
+    for (Cache* L1_cache : L1_caches) L1_cache->flushCache();
+    for (Cache* L2_cache : L2_caches) L2_cache->flushCache();
+    for (Cache* L3_cache : L3_caches) L3_cache->flushCache();
+    if (m_profile != nullptr) {
+        m_profile->setThreads(m_thread_profiles);
+    }
+}
+
+void CoreManager::attachSelfProfile(SelfProfile* t_profile) {
+    m_profile = t_profile;
+    m_thread_profiles.assign(t_profile != nullptr ? num_threads : 0, ThreadProfile());
+}
+
+void CoreManager::runWorkers(uint64_t t_requests) {
+    m_phase_remaining = t_requests;
+    threads.clear();
     for (int i = 0; i < num_threads; i++) {
         threads.emplace_back(&CoreManager::workerThread, this, i);
     }
@@ -56,23 +149,70 @@ void CoreManager::startSimulation() {
     for (auto& thread : threads) {
         if (thread.joinable()) thread.join();
     }
+}
 
-    for (Cache* L1_cache : L1_caches) L1_cache->flushCache();
-    for (Cache* L2_cache : L2_caches) L2_cache->flushCache();
-    for (Cache* L3_cache : L3_caches) L3_cache->flushCache();
+void CoreManager::endWarmup() {
+    m_stats->warmup_requests = params->warmup_requests - m_phase_remaining;
+    if (m_intervals != nullptr) {
+        m_intervals->markCountersReset(*m_stats);
+    }
+    m_stats->resetCounters();
+    memory.resetDramStats();
+    if (m_reuse_total != nullptr) {
+        m_reuse_total->resetCounts();
+        for (auto& profiler : m_reuse_per_core) profiler->resetCounts();
+    }
+    for (size_t k = 0; k < L1_caches.size(); k++) {
+        m_warmup_cycles[k] = L1_caches[k]->getTotalCycles();
+    }
+    for (Cache* L1_cache : L1_caches) L1_cache->resetSetProfile();
+    for (Cache* L2_cache : L2_caches) L2_cache->resetSetProfile();
+    for (Cache* L3_cache : L3_caches) L3_cache->resetSetProfile();
+}
+
+std::vector<std::pair<std::string, const Cache*>> CoreManager::labelledCaches() const {
+    std::vector<std::pair<std::string, const Cache*>> caches;
+    for (size_t k = 0; k < L1_caches.size(); k++) caches.emplace_back("L1." + std::to_string(k), L1_caches[k]);
+    for (size_t j = 0; j < L2_caches.size(); j++) caches.emplace_back("L2." + std::to_string(j), L2_caches[j]);
+    for (size_t i = 0; i < L3_caches.size(); i++) caches.emplace_back("L3." + std::to_string(i), L3_caches[i]);
+    return caches;
 }
 
 void CoreManager::workerThread(int thread_id) {
     Cache* L1_cache = L1_caches[thread_id];
+    ThreadProfile* profile = m_thread_profiles.empty() ? nullptr : &m_thread_profiles[thread_id];
+    ProfiledMutex::setThreadProfile(profile);
+    ProfileClock::time_point started = (profile != nullptr) ? ProfileClock::now() : ProfileClock::time_point();
+    std::unique_ptr<PerfCounters> counters;
+    PerfSample counters_start;
+    if (profile != nullptr && m_profile->hasPerfCounters()) {
+        counters = std::make_unique<PerfCounters>(false);
+        counters_start = counters->read();
+    }
     while (true) {
         std::optional<MemoryRequest> opt_request;
         {
-            std::lock_guard<std::mutex> lock(fm_mutex);
-            if (fm->getNumOperations() == 0) break;
+            std::lock_guard<ProfiledMutex> lock(fm_mutex);
+            if (fm->getNumOperations() == 0 || m_phase_remaining == 0) break;
+            m_phase_remaining--;
             opt_request = fm->getNextRequest();
+            if (m_reuse_total != nullptr && opt_request.has_value()) {
+                m_reuse_total->record(opt_request->address);
+            }
+            if (m_intervals != nullptr) {
+                m_intervals->observe(*m_stats);
+            }
         }
         if (opt_request.has_value()) {
             MemoryRequest request = opt_request.value();
+            if (m_reuse_total != nullptr) {
+                m_reuse_per_core[thread_id]->record(request.address);
+            }
+            ProfileClock::time_point access_start;
+            if (profile != nullptr) {
+                profile->in_access = true;
+                access_start = ProfileClock::now();
+            }
             if (request.type == AccessType::READ) {
                 int value = L1_cache->read(request.address);
                 if (isVerbose) {
@@ -86,47 +226,72 @@ void CoreManager::workerThread(int thread_id) {
                               << request.address << " | Value: " << request.value << std::dec << std::endl;
                 }
             }
+            if (profile != nullptr) {
+                profile->busy += ProfileClock::now() - access_start;
+                profile->in_access = false;
+                profile->requests++;
+            }
         } else {
             throw CacheException("Error retrieving next memory request.");
         }
     }
+    if (profile != nullptr) {
+        profile->lifetime += ProfileClock::now() - started;
+        if (counters != nullptr) profile->counters += counters->read() - counters_start;
+        ProfiledMutex::setThreadProfile(nullptr);
+    }
+}
+
+void CoreManager::printReuseSummary() const {
+    if (m_reuse_total == nullptr) return;
+    m_reuse_total->printSummary("all cores");
+    for (size_t core = 0; core < m_reuse_per_core.size(); core++) {
+        m_reuse_per_core[core]->printSummary("core " + std::to_string(core));
+    }
 }
 
-void CoreManager::invalidateOtherCaches(uint32_t address, Cache* requester) {
-    std::lock_guard<std::mutex> lock(fm_mutex);
+// a write needs the only copy, so every other valid copy goes, EXCLUSIVE ones left by read misses
+// and ones parked in a core's victim cache too. dirty data is written back on the way out
+void CoreManager::invalidateOtherCaches(uint64_t address, Cache* requester) {
+    std::lock_guard<ProfiledMutex> lock(fm_mutex);
 
     for (Cache* cache : L1_caches) {
         if (cache != requester) {
-            CacheLine* line = cache->findCacheLine(address);
-            if (line && (line->m_mesi_state == MESI_State::SHARED || line->m_mesi_state == MESI_State::MODIFIED)) {
-                line->m_mesi_state = MESI_State::INVALID;
+            CoherenceCopy dropped = cache->invalidateForCoherence(address);
+            if (dropped != CoherenceCopy::NONE) {
+                m_stats->coherence_invalidations++;
+            }
+            if (dropped == CoherenceCopy::DIRTY) {
+                m_stats->coherence_writebacks++;
             }
         }
     }
 }
 
-void CoreManager::downgradeModifiedToShared(uint32_t address, Cache* requester) {
-    std::lock_guard<std::mutex> lock(fm_mutex);
+void CoreManager::downgradeModifiedToShared(uint64_t address, Cache* requester) {
+    std::lock_guard<ProfiledMutex> lock(fm_mutex);
 
     for (Cache* cache : L1_caches) {
         if (cache != requester) {
             CacheLine* line = cache->findCacheLine(address);
             if (line && line->m_mesi_state == MESI_State::MODIFIED) {
                 line->m_mesi_state = MESI_State::SHARED;
+                m_stats->coherence_downgrades++;
             }
         }
     }
 }
 
-void CoreManager::handleWriteBackBeforeInvalidation(uint32_t address, Cache* requester) {
-    std::lock_guard<std::mutex> lock(fm_mutex);
+void CoreManager::handleWriteBackBeforeInvalidation(uint64_t address, Cache* requester) {
+    std::lock_guard<ProfiledMutex> lock(fm_mutex);
 
     for (Cache* cache : L1_caches) {
         if (cache != requester) {
             CacheLine* line = cache->findCacheLine(address);
             if (line && line->m_mesi_state == MESI_State::MODIFIED) {
-                cache->flushCache();
-                line->m_mesi_state = MESI_State::INVALID;
+                cache->invalidateForCoherence(address); // writes the dirty copy back, then drops it and any victim copy
+                m_stats->coherence_writebacks++;
+                m_stats->coherence_invalidations++;
             }
         }
     }
@@ -6,6 +6,9 @@
 #include <algorithm>
 #include "../cache/cache.h"
 #include "../cache/mesi.h"
+#include "../cache/reuse_profiler.h"
+#include "../io/interval_log.h"
+#include "self_profile.h"
 #include "../cli/arg_parser.h"
 #include "../io/file_manager.h"
 #include "../memory/memory.h"
@@ -22,24 +25,41 @@ public:
 
     void startSimulation();
     void workerThread(int thread_id);
-    void invalidateOtherCaches(uint32_t address, Cache* requester);
-    void downgradeModifiedToShared(uint32_t address, Cache* requester);
-    void handleWriteBackBeforeInvalidation(uint32_t address, Cache* requester);
+    void invalidateOtherCaches(uint64_t address, Cache* requester);
+    void downgradeModifiedToShared(uint64_t address, Cache* requester);
+    void handleWriteBackBeforeInvalidation(uint64_t address, Cache* requester);
+    static void configureLevel(Cache* t_cache, Level t_level, const ValidParams& t_params);
+    void printReuseSummary() const;
+    void attachSelfProfile(SelfProfile* t_profile);
+    std::vector<std::pair<std::string, const Cache*>> labelledCaches() const; // "L1.<core>", "L2.<i>", "L3.<i>"
 
     // for testing
     int getNumL1Caches() const { return L1_caches.size(); }
     int getNumL2Caches() const { return L2_caches.size(); }
     int getNumL3Caches() const { return L3_caches.size(); }
+    Cache* getL1Cache(int t_core) const { return L1_caches[t_core]; }
+    const ReuseProfiler* getReuseProfiler() const { return m_reuse_total.get(); }
+    const ReuseProfiler* getCoreReuseProfiler(int t_core) const { return m_reuse_per_core[t_core].get(); }
 private:
+    void runWorkers(uint64_t t_requests);
+    void endWarmup();
+
     int num_threads;
     ValidParams* params;
     FileManager* fm;
-    Memory memory;
+    Memory& memory;
     bool isVerbose;
     CacheStats* m_stats;
     std::vector<std::thread> threads;
     std::vector<Cache*> L1_caches;
     std::vector<Cache*> L2_caches;
     std::vector<Cache*> L3_caches;
-    std::mutex fm_mutex;
+    ProfiledMutex fm_mutex;
+    uint64_t m_phase_remaining = 0; // requests the running phase may still take, guarded by fm_mutex
+    std::vector<uint64_t> m_warmup_cycles; // per core cycles at the end of the warm-up
+    std::unique_ptr<ReuseProfiler> m_reuse_total; // interleaved stream, in the order requests are handed out
+    std::vector<std::unique_ptr<ReuseProfiler>> m_reuse_per_core;
+    std::unique_ptr<IntervalLog> m_intervals; // optional, observed under fm_mutex as requests are handed out
+    SelfProfile* m_profile = nullptr; // optional, receives the phase times and m_thread_profiles
+    std::vector<ThreadProfile> m_thread_profiles; // one per worker, each written only by its own thread
 };
\ No newline at end of file
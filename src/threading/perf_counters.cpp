@@ -0,0 +1,117 @@
+#include "perf_counters.h"
+#include <cstring>
+#include <cerrno>
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+const char* PerfSample::counterName(int t_counter) {
+    static const char* const names[COUNTERS] = {"cycles", "instructions", "llc_misses", "branch_misses"};
+    return names[t_counter];
+}
+
+bool PerfSample::any() const {
+    for (int counter = 0; counter < COUNTERS; counter++) {
+        if (counted[counter]) return true;
+    }
+    return false;
+}
+
+double PerfSample::ipc() const {
+    if (!counted[CYCLES] || !counted[INSTRUCTIONS] || values[CYCLES] == 0) return 0.0;
+    return static_cast<double>(values[INSTRUCTIONS]) / values[CYCLES];
+}
+
+PerfSample& PerfSample::operator+=(const PerfSample& t_other) {
+    for (int counter = 0; counter < COUNTERS; counter++) {
+        values[counter] += t_other.values[counter];
+        counted[counter] = counted[counter] || t_other.counted[counter];
+    }
+    return *this;
+}
+
+// scaled counts can step back slightly between readings, so differences are clamped at zero
+PerfSample PerfSample::operator-(const PerfSample& t_earlier) const {
+    PerfSample difference;
+    for (int counter = 0; counter < COUNTERS; counter++) {
+        difference.counted[counter] = counted[counter] && t_earlier.counted[counter];
+        if (difference.counted[counter] && values[counter] > t_earlier.values[counter]) {
+            difference.values[counter] = values[counter] - t_earlier.values[counter];
+        }
+    }
+    return difference;
+}
+
+#ifdef __linux__
+
+// the usual refusals in words, anything else as the kernel reported it
+static std::string describeOpenError(int t_errno) {
+    if (t_errno == ENOENT || t_errno == EOPNOTSUPP) return "not supported by this host (no hardware PMU?)";
+    if (t_errno == EACCES || t_errno == EPERM) return "not permitted, see /proc/sys/kernel/perf_event_paranoid";
+    return std::strerror(t_errno);
+}
+
+PerfCounters::PerfCounters(bool t_inherit) {
+    static const uint64_t configs[PerfSample::COUNTERS] = {
+        PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES
+    };
+    // separate events rather than one group: the kernel cannot read an inherited group
+    for (int counter = 0; counter < PerfSample::COUNTERS; counter++) {
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.config = configs[counter];
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.inherit = t_inherit ? 1 : 0;
+        attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+        m_fds[counter] = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+        if (m_fds[counter] < 0 && m_error.empty()) {
+            m_error = std::string(PerfSample::counterName(counter)) + ": " + describeOpenError(errno);
+        }
+    }
+}
+
+PerfCounters::~PerfCounters() {
+    for (int fd : m_fds) {
+        if (fd >= 0) close(fd);
+    }
+}
+
+PerfSample PerfCounters::read() const {
+    PerfSample sample;
+    for (int counter = 0; counter < PerfSample::COUNTERS; counter++) {
+        uint64_t data[3]; // value, time enabled, time running
+        if (m_fds[counter] < 0 || ::read(m_fds[counter], data, sizeof(data)) != static_cast<ssize_t>(sizeof(data))) {
+            continue;
+        }
+        sample.counted[counter] = true;
+        sample.values[counter] = (data[2] == 0 || data[2] >= data[1])
+            ? data[0] : static_cast<uint64_t>(static_cast<double>(data[0]) * data[1] / data[2]);
+    }
+    return sample;
+}
+
+#else
+
+PerfCounters::PerfCounters(bool) : m_error("perf_event_open is only available on Linux") {
+    for (int& fd : m_fds) fd = -1;
+}
+
+PerfCounters::~PerfCounters() {}
+
+PerfSample PerfCounters::read() const {
+    return PerfSample();
+}
+
+#endif
+
+bool PerfCounters::isAvailable() const {
+    for (int fd : m_fds) {
+        if (fd >= 0) return true;
+    }
+    return false;
+}
@@ -0,0 +1,40 @@
+#pragma once
+#include <string>
+#include <cstdint>
+
+// host hardware counter values, or the difference of two readings. a counter the kernel refused
+// to open stays uncounted rather than reading as zero
+struct PerfSample {
+    enum Counter { CYCLES, INSTRUCTIONS, LLC_MISSES, BRANCH_MISSES, COUNTERS };
+
+    uint64_t values[COUNTERS] = {};
+    bool counted[COUNTERS] = {};
+
+    static const char* counterName(int t_counter); // "cycles", "instructions", "llc_misses", "branch_misses"
+    bool any() const;
+    double ipc() const; // instructions per cycle, 0 unless both were counted
+
+    PerfSample& operator+=(const PerfSample& t_other);
+    PerfSample operator-(const PerfSample& t_earlier) const;
+};
+
+// the four counters of PerfSample for the calling thread, user space only, read through
+// perf_event_open. with t_inherit the threads it starts later are counted as well once they exit,
+// which is how the main thread's phases cover the workers and the sweep pool. counters the host
+// cannot provide (no PMU in a VM, perf_event_paranoid, not Linux) are skipped and getError() says why
+class PerfCounters {
+
+public:
+    explicit PerfCounters(bool t_inherit);
+    ~PerfCounters();
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+    PerfSample read() const; // running totals, scaled up when the kernel multiplexed a counter
+    bool isAvailable() const; // at least one counter opened
+    const std::string& getError() const { return m_error; } // why the first missing counter was refused
+
+private:
+    int m_fds[PerfSample::COUNTERS];
+    std::string m_error;
+};
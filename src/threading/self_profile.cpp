@@ -0,0 +1,89 @@
+#include "self_profile.h"
+
+thread_local ThreadProfile* ProfiledMutex::s_thread_profile = nullptr;
+
+static double toMilliseconds(ProfileClock::duration t_duration) {
+    return std::chrono::duration<double, std::milli>(t_duration).count();
+}
+
+// prints the counters that were counted, nothing when none were
+static void printCounters(const PerfSample& t_counters) {
+    if (!t_counters.any()) return;
+    std::cout << "  host";
+    for (int counter = 0; counter < PerfSample::COUNTERS; counter++) {
+        if (t_counters.counted[counter]) {
+            std::cout << " " << PerfSample::counterName(counter) << " " << t_counters.values[counter];
+        }
+    }
+    if (t_counters.ipc() > 0) std::cout << " (IPC " << t_counters.ipc() << ")";
+    std::cout << "\n";
+}
+
+void SelfProfile::enablePerfCounters() {
+    m_perf = std::make_unique<PerfCounters>(true);
+}
+
+PerfSample SelfProfile::readCounters() const {
+    return m_perf != nullptr ? m_perf->read() : PerfSample();
+}
+
+// a phase that runs more than once (the warm-up and the measured run) adds up
+void SelfProfile::addPhase(const std::string& t_name, ProfileClock::duration t_duration, const PerfSample& t_counters) {
+    for (size_t i = 0; i < m_phases.size(); i++) {
+        if (m_phases[i].first == t_name) {
+            m_phases[i].second += t_duration;
+            m_phase_counters[i] += t_counters;
+            return;
+        }
+    }
+    m_phases.emplace_back(t_name, t_duration);
+    m_phase_counters.push_back(t_counters);
+}
+
+double SelfProfile::phaseSeconds(const std::string& t_name) const {
+    for (const auto& phase : m_phases) {
+        if (phase.first == t_name) {
+            return std::chrono::duration<double>(phase.second).count();
+        }
+    }
+    return 0.0;
+}
+
+double SelfProfile::requestsPerSecond() const {
+    double seconds = phaseSeconds("simulation");
+    return seconds > 0 ? m_requests / seconds : 0.0;
+}
+
+void SelfProfile::printSummary() const {
+    std::cout << "\n===== Simulator Self-Profile =====\n";
+    ProfileClock::duration total{0};
+    for (const auto& phase : m_phases) total += phase.second;
+    if (m_perf != nullptr && !m_perf->isAvailable()) {
+        std::cout << "Host Counters: unavailable (" << m_perf->getError() << ")\n";
+    }
+    for (size_t i = 0; i < m_phases.size(); i++) {
+        std::cout << "Phase " << m_phases[i].first << ": " << toMilliseconds(m_phases[i].second) << " ms ("
+                  << (total.count() == 0 ? 0.0 : 100.0 * m_phases[i].second.count() / total.count()) << "%)\n";
+        printCounters(m_phase_counters[i]);
+    }
+    std::cout << "Simulated Requests: " << m_requests << " (" << requestsPerSecond() << " requests/s)\n";
+
+    uint64_t acquisitions = 0, contended = 0;
+    ProfileClock::duration lock_wait{0};
+    for (size_t thread = 0; thread < m_threads.size(); thread++) {
+        const ThreadProfile& profile = m_threads[thread];
+        std::cout << "Thread " << thread << ": " << profile.requests << " requests, simulating " << toMilliseconds(profile.simulating())
+                  << " ms, lock wait " << toMilliseconds(profile.lock_wait) << " ms, idle " << toMilliseconds(profile.idle())
+                  << " ms of " << toMilliseconds(profile.lifetime) << " ms\n";
+        printCounters(profile.counters);
+        acquisitions += profile.lock_acquisitions;
+        contended += profile.contended_acquisitions;
+        lock_wait += profile.lock_wait;
+    }
+    if (!m_threads.empty()) {
+        std::cout << "fm_mutex: " << acquisitions << " acquisitions, " << contended << " contended ("
+                  << (acquisitions == 0 ? 0.0 : 100.0 * contended / acquisitions) << "%), "
+                  << toMilliseconds(lock_wait) << " ms waited\n";
+    }
+    std::cout << "==================================\n";
+}
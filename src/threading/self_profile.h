@@ -0,0 +1,115 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <chrono>
+#include <mutex>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include "perf_counters.h"
+
+using ProfileClock = std::chrono::steady_clock;
+
+// where one worker thread's wall time went, accumulated over every phase it ran in
+struct ThreadProfile {
+    uint64_t requests = 0;
+    ProfileClock::duration lifetime{0}; // from the thread's start to its exit
+    ProfileClock::duration busy{0}; // inside L1 reads and writes, lock waits included
+    ProfileClock::duration lock_wait{0}; // waiting for fm_mutex, wherever it was taken
+    ProfileClock::duration access_lock_wait{0}; // the part of lock_wait spent inside an access (coherence)
+    uint64_t lock_acquisitions = 0;
+    uint64_t contended_acquisitions = 0; // the mutex was already held when the thread asked for it
+    bool in_access = false;
+    PerfSample counters; // the worker's own host counters, with --perf_counters
+
+    // lifetime = simulating + lock_wait + idle
+    ProfileClock::duration simulating() const { return busy - access_lock_wait; }
+    ProfileClock::duration idle() const { return lifetime - busy - (lock_wait - access_lock_wait); }
+};
+
+// std::mutex that charges contention to the calling thread's profile. an uncontended acquisition
+// costs one try_lock, the same as lock(); the clock is only read once a thread has to wait.
+// threads without a profile (the default) lock it like a plain mutex
+class ProfiledMutex {
+
+public:
+    void lock() {
+        ThreadProfile* profile = s_thread_profile;
+        if (profile == nullptr) {
+            m_mutex.lock();
+            return;
+        }
+        profile->lock_acquisitions++;
+        if (m_mutex.try_lock()) {
+            return;
+        }
+        profile->contended_acquisitions++;
+        ProfileClock::time_point start = ProfileClock::now();
+        m_mutex.lock();
+        ProfileClock::duration waited = ProfileClock::now() - start;
+        profile->lock_wait += waited;
+        if (profile->in_access) {
+            profile->access_lock_wait += waited;
+        }
+    }
+    bool try_lock() { return m_mutex.try_lock(); }
+    void unlock() { m_mutex.unlock(); }
+
+    static void setThreadProfile(ThreadProfile* t_profile) { s_thread_profile = t_profile; }
+
+private:
+    std::mutex m_mutex;
+    static thread_local ThreadProfile* s_thread_profile;
+};
+
+// the simulator's own performance: wall time per phase, request throughput and, for
+// multi-threaded runs, how each worker split its time and how contended fm_mutex was.
+// with host counters enabled every phase also records cycles, instructions, LLC and branch misses
+class SelfProfile {
+
+public:
+    void enablePerfCounters(); // before any worker starts, so the phases inherit into them
+    bool hasPerfCounters() const { return m_perf != nullptr; }
+    PerfSample readCounters() const; // uncounted without host counters
+    void addPhase(const std::string& t_name, ProfileClock::duration t_duration, const PerfSample& t_counters = PerfSample());
+    void setRequests(uint64_t t_requests) { m_requests = t_requests; }
+    void setThreads(const std::vector<ThreadProfile>& t_threads) { m_threads = t_threads; }
+    void printSummary() const;
+
+    double phaseSeconds(const std::string& t_name) const; // 0 when the phase never ran
+    double requestsPerSecond() const; // over the simulation phase
+    const std::vector<std::pair<std::string, ProfileClock::duration>>& getPhases() const { return m_phases; }
+    const std::vector<PerfSample>& getPhaseCounters() const { return m_phase_counters; } // parallel to getPhases()
+    const std::vector<ThreadProfile>& getThreads() const { return m_threads; }
+    uint64_t getRequests() const { return m_requests; }
+
+private:
+    std::vector<std::pair<std::string, ProfileClock::duration>> m_phases; // in the order they first ran
+    std::vector<PerfSample> m_phase_counters;
+    std::unique_ptr<PerfCounters> m_perf; // main thread's counters, inherited by the threads it starts
+    std::vector<ThreadProfile> m_threads;
+    uint64_t m_requests = 0;
+};
+
+// times its scope into a phase of the profile, does nothing without one
+class ScopedPhase {
+
+public:
+    ScopedPhase(SelfProfile* t_profile, const char* t_name)
+        : m_profile(t_profile), m_name(t_name), m_start(t_profile != nullptr ? ProfileClock::now() : ProfileClock::time_point()) {
+        if (m_profile != nullptr) m_counters = m_profile->readCounters();
+    }
+    ~ScopedPhase() {
+        if (m_profile != nullptr) {
+            m_profile->addPhase(m_name, ProfileClock::now() - m_start, m_profile->readCounters() - m_counters);
+        }
+    }
+    ScopedPhase(const ScopedPhase&) = delete;
+    ScopedPhase& operator=(const ScopedPhase&) = delete;
+
+private:
+    SelfProfile* m_profile;
+    const char* m_name;
+    ProfileClock::time_point m_start;
+    PerfSample m_counters;
+};
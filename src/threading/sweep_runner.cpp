@@ -0,0 +1,180 @@
+#include "sweep_runner.h"
+#include <atomic>
+#include <thread>
+#include <iomanip>
+#include <stdexcept>
+#include "core_hierarchy.h"
+
+SweepRunner::SweepRunner(const ValidParams& t_params, const std::vector<MemoryRequest>& t_requests, int t_memory_size)
+    : m_params(t_params), m_requests(t_requests), m_memory_size(t_memory_size) {}
+
+// an empty list sweeps only the value the rest of the command line selected
+std::vector<SweepPoint> SweepRunner::expandPoints() const {
+    std::vector<int> l1_sizes = m_params.sweep_l1_sizes.empty() ? std::vector<int>{m_params.l1_cache_size} : m_params.sweep_l1_sizes;
+    std::vector<int> l2_sizes = m_params.sweep_l2_sizes.empty() ? std::vector<int>{m_params.l2_cache_size} : m_params.sweep_l2_sizes;
+    std::vector<int> l3_sizes = m_params.sweep_l3_sizes.empty() ? std::vector<int>{m_params.l3_cache_size} : m_params.sweep_l3_sizes;
+    std::vector<int> assocs = m_params.sweep_associativities.empty() ? std::vector<int>{m_params.associativity} : m_params.sweep_associativities;
+    std::vector<std::string> policies = m_params.sweep_policies.empty()
+        ? std::vector<std::string>{m_params.replacement_policy} : m_params.sweep_policies;
+    std::vector<std::string> write_policies = m_params.sweep_write_policies.empty()
+        ? std::vector<std::string>{m_params.write_policy} : m_params.sweep_write_policies;
+
+    std::vector<SweepPoint> points;
+    for (int l1 : l1_sizes)
+        for (int l2 : l2_sizes)
+            for (int l3 : l3_sizes)
+                for (int assoc : assocs)
+                    for (const std::string& policy : policies)
+                        for (const std::string& write_policy : write_policies)
+                            points.push_back({l1, l2, l3, assoc, policy, write_policy});
+    return points;
+}
+
+ValidParams SweepRunner::applyPoint(const ValidParams& t_params, const SweepPoint& t_point) {
+    ValidParams params = t_params;
+    params.l1_cache_size = t_point.l1_cache_size;
+    params.l2_cache_size = t_point.l2_cache_size;
+    params.l3_cache_size = t_point.l3_cache_size;
+    // a dimension that is not swept keeps any per-level values given with -lX_assoc, -lX_policy, ...
+    if (!t_params.sweep_associativities.empty()) {
+        params.associativity = params.l1_associativity = params.l2_associativity = params.l3_associativity = t_point.associativity;
+    }
+    if (!t_params.sweep_policies.empty()) {
+        params.replacement_policy = params.l1_replacement_policy = params.l2_replacement_policy = params.l3_replacement_policy = t_point.replacement_policy;
+    }
+    if (!t_params.sweep_write_policies.empty()) {
+        params.write_policy = params.l1_write_policy = params.l2_write_policy = params.l3_write_policy = t_point.write_policy;
+    }
+    params.isVerbose = false; // workers would interleave their logs
+    return params;
+}
+
+void SweepRunner::simulatePoint(SweepResult& t_result, Memory& t_memory) const {
+    ValidParams params = applyPoint(m_params, t_result.point);
+    if (params.dram_enabled) {
+        t_memory.attachDram(params.dram);
+    }
+    try {
+        CoreHierarchy hierarchy(params, t_memory, &t_result.stats);
+        for (const MemoryRequest& request : m_requests) {
+            hierarchy.access(request);
+        }
+        hierarchy.finish();
+    } catch (const std::exception& e) {
+        t_result.error = e.what();
+    }
+}
+
+// points t_begin..t_end advance together one batch of requests at a time. a point that fails to
+// build or throws mid-trace, or while flushing, drops out with its error and the rest of the group carries on
+void SweepRunner::simulateLockstep(std::vector<SweepResult>& t_results, std::vector<std::unique_ptr<Memory>>& t_memories,
+                                   size_t t_begin, size_t t_end, size_t t_batch) const {
+    std::vector<std::unique_ptr<CoreHierarchy>> hierarchies(t_end - t_begin);
+    for (size_t i = t_begin; i < t_end; i++) {
+        ValidParams params = applyPoint(m_params, t_results[i].point);
+        if (params.dram_enabled) {
+            t_memories[i]->attachDram(params.dram);
+        }
+        try {
+            hierarchies[i - t_begin] = std::make_unique<CoreHierarchy>(params, *t_memories[i], &t_results[i].stats);
+        } catch (const std::exception& e) {
+            t_results[i].error = e.what();
+        }
+    }
+
+    for (size_t start = 0; start < m_requests.size(); start += t_batch) {
+        size_t stop = std::min(start + t_batch, m_requests.size());
+        for (size_t i = t_begin; i < t_end; i++) {
+            std::unique_ptr<CoreHierarchy>& hierarchy = hierarchies[i - t_begin];
+            if (hierarchy == nullptr) continue;
+            try {
+                for (size_t r = start; r < stop; r++) {
+                    hierarchy->access(m_requests[r]);
+                }
+            } catch (const std::exception& e) {
+                t_results[i].error = e.what();
+                hierarchy.reset();
+            }
+        }
+    }
+
+    for (size_t i = t_begin; i < t_end; i++) {
+        if (hierarchies[i - t_begin] == nullptr) continue;
+        try {
+            hierarchies[i - t_begin]->finish();
+        } catch (const std::exception& e) {
+            t_results[i].error = e.what();
+        }
+    }
+}
+
+// workers claim the next unsimulated point until none are left, or in lockstep mode take one
+// contiguous group of points each. results keep the expansion order
+std::vector<SweepResult> SweepRunner::run(int t_num_workers, size_t t_lockstep_batch) const {
+    std::vector<SweepPoint> points = expandPoints();
+    std::vector<SweepResult> results(points.size());
+    std::vector<std::unique_ptr<Memory>> memories; // built up front so their banners do not interleave
+    for (size_t i = 0; i < points.size(); i++) {
+        results[i].point = points[i];
+        memories.push_back(std::make_unique<Memory>(m_memory_size, false, m_params.full_address_space));
+    }
+
+    if (t_num_workers <= 0) {
+        t_num_workers = std::max(1u, std::thread::hardware_concurrency());
+    }
+    t_num_workers = std::min<int>(t_num_workers, static_cast<int>(points.size()));
+
+    std::atomic<size_t> next_point{0};
+    auto worker = [&]() {
+        for (size_t i = next_point++; i < results.size(); i = next_point++) {
+            simulatePoint(results[i], *memories[i]);
+        }
+    };
+    std::vector<std::thread> workers;
+    for (int i = 0; i < t_num_workers; i++) {
+        if (t_lockstep_batch == 0) {
+            workers.emplace_back(worker);
+            continue;
+        }
+        size_t begin = results.size() * i / t_num_workers;
+        size_t end = results.size() * (i + 1) / t_num_workers;
+        workers.emplace_back([&, begin, end]() { simulateLockstep(results, memories, begin, end, t_lockstep_batch); });
+    }
+    for (std::thread& thread : workers) {
+        thread.join();
+    }
+    return results;
+}
+
+// error messages are free text, so they are always quoted with any quotes doubled
+static std::string quoteCsv(const std::string& t_text) {
+    std::string quoted = "\"";
+    for (char c : t_text) {
+        if (c == '"') quoted += '"';
+        quoted += c;
+    }
+    return quoted + "\"";
+}
+
+void SweepRunner::writeResults(const std::vector<SweepResult>& t_results, std::ostream& t_out) {
+    auto rate = [](int hits, int misses) {
+        return (hits + misses) == 0 ? 0.0 : 100.0 * hits / (hits + misses);
+    };
+    t_out << "l1_size,l2_size,l3_size,assoc,policy,write_policy,l1_hit_rate,l2_hit_rate,l3_hit_rate,"
+          << "memory_accesses,dirty_evictions,cycles,amat,error\n";
+    t_out << std::fixed << std::setprecision(3);
+    for (const SweepResult& result : t_results) {
+        const SweepPoint& point = result.point;
+        const CacheStats& stats = result.stats;
+        t_out << point.l1_cache_size << "," << point.l2_cache_size << "," << point.l3_cache_size << ","
+              << point.associativity << "," << point.replacement_policy << "," << point.write_policy << ",";
+        if (!result.error.empty()) {
+            t_out << ",,,,,,," << quoteCsv(result.error) << "\n";
+            continue;
+        }
+        uint64_t cycles = stats.core_cycles.empty() ? 0 : stats.core_cycles.front();
+        t_out << rate(stats.l1_hits, stats.l1_misses) << "," << rate(stats.l2_hits, stats.l2_misses) << ","
+              << rate(stats.l3_hits, stats.l3_misses) << "," << stats.memory_accesses << ","
+              << stats.dirty_evictions << "," << cycles << "," << stats.averageMemoryAccessTime() << ",\n";
+    }
+}
@@ -0,0 +1,49 @@
+#pragma once
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "../cache/cache.h"
+#include "../cli/arg_parser.h"
+#include "../io/file_manager.h"
+#include "../memory/memory.h"
+
+// one point of the design space, every level shares the point's associativity and policies
+struct SweepPoint {
+    int l1_cache_size;
+    int l2_cache_size;
+    int l3_cache_size;
+    int associativity;
+    std::string replacement_policy;
+    std::string write_policy;
+};
+
+struct SweepResult {
+    SweepPoint point;
+    CacheStats stats;
+    std::string error; // set when the point could not be built, e.g. a size that does not divide into sets
+};
+
+// simulates the cartesian product of the sweep lists in ValidParams. the trace is parsed once and
+// shared read-only, each point runs its own single-core hierarchy and memory on a pool of workers.
+// in lockstep mode each worker owns a group of points and replays every batch of requests through
+// all of them before decoding the next, so one pass over the trace serves the whole group
+class SweepRunner {
+
+public:
+    SweepRunner(const ValidParams& t_params, const std::vector<MemoryRequest>& t_requests, int t_memory_size);
+
+    std::vector<SweepPoint> expandPoints() const;
+    std::vector<SweepResult> run(int t_num_workers, size_t t_lockstep_batch = 0) const;
+    static ValidParams applyPoint(const ValidParams& t_params, const SweepPoint& t_point);
+    static void writeResults(const std::vector<SweepResult>& t_results, std::ostream& t_out);
+
+private:
+    void simulatePoint(SweepResult& t_result, Memory& t_memory) const;
+    void simulateLockstep(std::vector<SweepResult>& t_results, std::vector<std::unique_ptr<Memory>>& t_memories,
+                          size_t t_begin, size_t t_end, size_t t_batch) const;
+
+    const ValidParams& m_params;
+    const std::vector<MemoryRequest>& m_requests;
+    int m_memory_size;
+};
@@ -78,6 +78,7 @@ TEST_CASE("Arg Parser - Replacement Policy", "[arg_parser]") {
         std::make_tuple("-policy", "LFU", true),
         std::make_tuple("-policy", "LRU", true),
         std::make_tuple("-policy", "FIFO", true),
+        std::make_tuple("-policy", "PLRU", true),
         std::make_tuple("-policy", "TEST", false),
         std::make_tuple("-policies", "LRU", false)
     );
@@ -110,7 +111,9 @@ TEST_CASE("Arg Parser - Associativity", "[arg_parser]") {
         std::make_tuple("-assoc", "1", true),
         std::make_tuple("-assoc", "4", true),
         std::make_tuple("-assoc", "0", true),
-        std::make_tuple("-assoc", "2", false),
+        std::make_tuple("-assoc", "2", true),
+        std::make_tuple("-assoc", "20", true),
+        std::make_tuple("-assoc", "65", false),
         std::make_tuple("-assoc", "one", false),
         std::make_tuple("-associativity", "1", false)
     );
@@ -249,4 +252,621 @@ TEST_CASE("Arg Parser - Valid without Verbose", "[arg_parser]") {
     ArgParser argParser(validInputCount, validInput);
 
     REQUIRE(argParser.validateArguments());
-}
\ No newline at end of file
+}
+TEST_CASE("Arg Parser - Inclusion Policy", "[arg_parser]") {
+    auto [inclusionParam, inclusionValue, expectedResult] = GENERATE(
+        std::make_tuple("-l2_inclusion", "INCLUSIVE", true),
+        std::make_tuple("-l3_inclusion", "EXCLUSIVE", true),
+        std::make_tuple("-l2_inclusion", "NINE", true),
+        std::make_tuple("-l2_inclusion", "MOSTLY", false),
+        std::make_tuple("-l1_inclusion", "INCLUSIVE", false)
+    );
+
+    char* validInput[] = {
+        (char*)"./cache_test",
+        (char*)"-cache_size",
+        (char*)"small",
+        (char*)"-threads",
+        (char*)"4",
+        (char*)"-policy",
+        (char*)"LRU",
+        (char*)"-assoc",
+        (char*)"1",
+        (char*)"-write_policy",
+        (char*)"WB",
+        (char*)"-trace",
+        (char*)"memory_access.txt",
+        (char*)inclusionParam,
+        (char*)inclusionValue,
+        (char*)"--verbose"
+    };
+    int validInputCount = 16;
+
+    ArgParser argParser(validInputCount, validInput);
+
+    REQUIRE(argParser.validateArguments() == expectedResult);
+    if (expectedResult) {
+        ValidParams params = argParser.getValidParams();
+        REQUIRE(params.isVerbose);
+        std::string parsed = std::string(inclusionParam) == "-l2_inclusion" ? params.l2_inclusion_policy : params.l3_inclusion_policy;
+        REQUIRE(parsed == inclusionValue);
+    }
+}
+
+TEST_CASE("Arg Parser - DRAM Options", "[arg_parser][dram]") {
+    auto [dramParam, dramValue, expectedResult] = GENERATE(
+        std::make_tuple("-dram_banks", "16", true),
+        std::make_tuple("-dram_row_policy", "CLOSED", true),
+        std::make_tuple("-dram_row_size", "2048", true),
+        std::make_tuple("-dram_row_size", "100", false),
+        std::make_tuple("-dram_channels", "0", false),
+        std::make_tuple("-dram_row_policy", "ADAPTIVE", false)
+    );
+
+    char* validInput[] = {
+        (char*)"./cache_test",
+        (char*)"-cache_size",
+        (char*)"small",
+        (char*)"-threads",
+        (char*)"1",
+        (char*)"-policy",
+        (char*)"LRU",
+        (char*)"-assoc",
+        (char*)"1",
+        (char*)"-write_policy",
+        (char*)"WB",
+        (char*)"-trace",
+        (char*)"memory_access.txt",
+        (char*)"--dram",
+        (char*)dramParam,
+        (char*)dramValue
+    };
+    int validInputCount = 16;
+
+    ArgParser argParser(validInputCount, validInput);
+
+    REQUIRE(argParser.validateArguments() == expectedResult);
+    if (expectedResult) {
+        ValidParams params = argParser.getValidParams();
+        REQUIRE(params.dram_enabled);
+        REQUIRE_FALSE(params.isVerbose);
+        if (std::string(dramParam) == "-dram_banks") REQUIRE(params.dram.banks == 16);
+        if (std::string(dramParam) == "-dram_row_policy") REQUIRE(params.dram.row_policy == "CLOSED");
+        if (std::string(dramParam) == "-dram_row_size") REQUIRE(params.dram.row_size == 2048);
+    }
+}
+
+TEST_CASE("Arg Parser - Per Level Geometry", "[arg_parser]") {
+    auto [flag, value, expectedResult] = GENERATE(
+        std::make_tuple("-l1_size", "48KB", true),
+        std::make_tuple("-l3_size", "30MB", true),
+        std::make_tuple("-l2_assoc", "20", true),
+        std::make_tuple("-l1_size", "48kb", false),
+        std::make_tuple("-l3_assoc", "128", false),
+        std::make_tuple("-config", "examples/configs/skylake_server.cfg", true),
+        std::make_tuple("-config", "examples/tests/invalid_config.cfg", false),
+        std::make_tuple("-config", "examples/configs/missing.cfg", false)
+    );
+
+    char* validInput[] = {
+        (char*)"./cache_test",
+        (char*)"-cache_size",
+        (char*)"small",
+        (char*)"-threads",
+        (char*)"1",
+        (char*)"-policy",
+        (char*)"LRU",
+        (char*)"-assoc",
+        (char*)"4",
+        (char*)"-write_policy",
+        (char*)"WB",
+        (char*)"-trace",
+        (char*)"memory_access.txt",
+        (char*)flag,
+        (char*)value
+    };
+    int validInputCount = 15;
+
+    ArgParser argParser(validInputCount, validInput);
+
+    REQUIRE(argParser.validateArguments() == expectedResult);
+    if (expectedResult) {
+        ValidParams params = argParser.getValidParams();
+        std::string option = flag;
+        if (option == "-l1_size") REQUIRE(params.l1_cache_size == 48 * 1024);
+        if (option == "-l3_size") REQUIRE(params.l3_cache_size == 30 * 1024 * 1024);
+        if (option == "-l2_assoc") {
+            REQUIRE(params.l2_associativity == 20);
+            REQUIRE(params.l1_associativity == 4);
+        }
+        if (option == "-config") {
+            REQUIRE(params.l1_cache_size == 48 * 1024);
+            REQUIRE(params.l1_associativity == 12);
+            REQUIRE(params.l2_cache_size == 2 * 1024 * 1024);
+            REQUIRE(params.l3_associativity == 20);
+            REQUIRE(params.associativity == 4);
+        }
+    }
+}
+
+TEST_CASE("Arg Parser - Per Level Policies", "[arg_parser]") {
+    auto [flag, value, expectedResult] = GENERATE(
+        std::make_tuple("-l1_policy", "PLRU", true),
+        std::make_tuple("-l3_policy", "FIFO", true),
+        std::make_tuple("-l2_write_policy", "WT", true),
+        std::make_tuple("-l1_policy", "RANDOM", false),
+        std::make_tuple("-l3_write_policy", "WA", false)
+    );
+
+    char* validInput[] = {
+        (char*)"./cache_test",
+        (char*)"-cache_size",
+        (char*)"small",
+        (char*)"-threads",
+        (char*)"1",
+        (char*)"-policy",
+        (char*)"LRU",
+        (char*)"-assoc",
+        (char*)"4",
+        (char*)"-write_policy",
+        (char*)"WB",
+        (char*)"-trace",
+        (char*)"memory_access.txt",
+        (char*)flag,
+        (char*)value
+    };
+    int validInputCount = 15;
+
+    ArgParser argParser(validInputCount, validInput);
+
+    REQUIRE(argParser.validateArguments() == expectedResult);
+    if (expectedResult) {
+        ValidParams params = argParser.getValidParams();
+        std::string option = flag;
+        if (option == "-l1_policy") {
+            REQUIRE(params.l1_replacement_policy == "PLRU");
+            REQUIRE(params.l2_replacement_policy == "LRU");
+        }
+        if (option == "-l3_policy") REQUIRE(params.l3_replacement_policy == "FIFO");
+        if (option == "-l2_write_policy") {
+            REQUIRE(params.l2_write_policy == "WT");
+            REQUIRE(params.l1_write_policy == "WB");
+            REQUIRE(params.write_policy == "WB");
+        }
+    }
+}
+
+TEST_CASE("Arg Parser - Sweep Lists", "[arg_parser][sweep]") {
+    auto [flag, value, expectedResult] = GENERATE(
+        std::make_tuple("-sweep_l1_size", "16KB,32KB,48KB", true),
+        std::make_tuple("-sweep_assoc", "1,4,8,16", true),
+        std::make_tuple("-sweep_policy", "LRU,PLRU", true),
+        std::make_tuple("-sweep_write_policy", "WB,WT", true),
+        std::make_tuple("-sweep_l2_size", "256KB,,1MB", false),
+        std::make_tuple("-sweep_assoc", "4,", false),
+        std::make_tuple("-sweep_policy", "LRU,MRU", false),
+        std::make_tuple("-sweep_lockstep", "4096", true),
+        std::make_tuple("-sweep_lockstep", "2000000", false),
+        std::make_tuple("-sweep_jobs", "999", false)
+    );
+
+    char* validInput[] = {
+        (char*)"./cache_test",
+        (char*)"-cache_size",
+        (char*)"small",
+        (char*)"-threads",
+        (char*)"1",
+        (char*)"-policy",
+        (char*)"LRU",
+        (char*)"-assoc",
+        (char*)"4",
+        (char*)"-write_policy",
+        (char*)"WB",
+        (char*)"-trace",
+        (char*)"memory_access.txt",
+        (char*)flag,
+        (char*)value
+    };
+    int validInputCount = 15;
+
+    ArgParser argParser(validInputCount, validInput);
+
+    REQUIRE(argParser.validateArguments() == expectedResult);
+    if (expectedResult) {
+        ValidParams params = argParser.getValidParams();
+        std::string option = flag;
+        REQUIRE(params.sweep_enabled == (option != "-sweep_lockstep"));
+        if (option == "-sweep_l1_size") REQUIRE(params.sweep_l1_sizes == std::vector<int>{16 * 1024, 32 * 1024, 48 * 1024});
+        if (option == "-sweep_assoc") REQUIRE(params.sweep_associativities.size() == 4);
+        if (option == "-sweep_policy") REQUIRE(params.sweep_policies == std::vector<std::string>{"LRU", "PLRU"});
+        if (option == "-sweep_write_policy") REQUIRE(params.sweep_l1_sizes.empty());
+        if (option == "-sweep_lockstep") REQUIRE(params.sweep_lockstep_batch == 4096);
+    }
+}
+
+TEST_CASE("Arg Parser - L3 Set Sampling", "[arg_parser][sampling]") {
+    auto [value, filter, expectedResult] = GENERATE(
+        std::make_tuple("32", false, true),
+        std::make_tuple("1", true, true),
+        std::make_tuple("64", true, true),
+        std::make_tuple("0", false, false),
+        std::make_tuple("2048", false, false)
+    );
+
+    char* validInput[] = {
+        (char*)"./cache_test",
+        (char*)"-cache_size",
+        (char*)"large",
+        (char*)"-threads",
+        (char*)"1",
+        (char*)"-policy",
+        (char*)"LRU",
+        (char*)"-assoc",
+        (char*)"8",
+        (char*)"-write_policy",
+        (char*)"WB",
+        (char*)"-trace",
+        (char*)"memory_access.txt",
+        (char*)"-l3_set_sampling",
+        (char*)value,
+        (char*)"--sample_all_levels"
+    };
+    int validInputCount = filter ? 16 : 15;
+
+    ArgParser argParser(validInputCount, validInput);
+
+    REQUIRE(argParser.validateArguments() == expectedResult);
+    if (expectedResult) {
+        ValidParams params = argParser.getValidParams();
+        REQUIRE(params.l3_set_sampling == std::stoi(value));
+        REQUIRE(params.sample_all_levels == filter);
+    }
+}
+
+TEST_CASE("Arg Parser - Time Sampling", "[arg_parser][sampling]") {
+    auto [threads, period, unit, expectedResult] = GENERATE(
+        std::make_tuple("1", "10000", "1000", true),
+        std::make_tuple("1", "0", "1000", true),
+        std::make_tuple("1", "500", "1000", false),
+        std::make_tuple("1", "10000", "0", false),
+        std::make_tuple("1", "10000", "abc", false),
+        std::make_tuple("2", "10000", "1000", false),
+        std::make_tuple("2", "0", "1000", true)
+    );
+
+    char* validInput[] = {
+        (char*)"./cache_test",
+        (char*)"-cache_size",
+        (char*)"small",
+        (char*)"-threads",
+        (char*)threads,
+        (char*)"-policy",
+        (char*)"LRU",
+        (char*)"-assoc",
+        (char*)"4",
+        (char*)"-write_policy",
+        (char*)"WB",
+        (char*)"-trace",
+        (char*)"memory_access.txt",
+        (char*)"-time_sampling",
+        (char*)period,
+        (char*)"-sample_unit",
+        (char*)unit
+    };
+    int validInputCount = 17;
+
+    ArgParser argParser(validInputCount, validInput);
+
+    REQUIRE(argParser.validateArguments() == expectedResult);
+    if (expectedResult) {
+        ValidParams params = argParser.getValidParams();
+        REQUIRE(params.time_sample_period == std::stoi(period));
+        REQUIRE(params.time_sample_unit == std::stoi(unit));
+    }
+}
+
+TEST_CASE("Arg Parser - Checkpoints", "[arg_parser][checkpoint]") {
+    auto [threads, flag, value, extraFlag, extraValue, expectedResult] = GENERATE(
+        std::make_tuple("1", "-checkpoint_save", "warm.ckpt", "-checkpoint_at", "50000", true),
+        std::make_tuple("1", "-checkpoint_restore", "warm.ckpt", "-checkpoint_save", "later.ckpt", true),
+        std::make_tuple("1", "-checkpoint_restore", "warm.ckpt", "-checkpoint_at", "50000", false),
+        std::make_tuple("2", "-checkpoint_save", "warm.ckpt", "-checkpoint_at", "50000", false),
+        std::make_tuple("1", "-checkpoint_restore", "warm.ckpt", "-sweep_assoc", "4,8", false),
+        std::make_tuple("1", "-checkpoint_save", "warm.ckpt", "-checkpoint_at", "-5", false)
+    );
+
+    char* validInput[] = {
+        (char*)"./cache_test",
+        (char*)"-cache_size",
+        (char*)"small",
+        (char*)"-threads",
+        (char*)threads,
+        (char*)"-policy",
+        (char*)"LRU",
+        (char*)"-assoc",
+        (char*)"4",
+        (char*)"-write_policy",
+        (char*)"WB",
+        (char*)"-trace",
+        (char*)"memory_access.txt",
+        (char*)flag,
+        (char*)value,
+        (char*)extraFlag,
+        (char*)extraValue
+    };
+    int validInputCount = 17;
+
+    ArgParser argParser(validInputCount, validInput);
+
+    REQUIRE(argParser.validateArguments() == expectedResult);
+    if (expectedResult) {
+        ValidParams params = argParser.getValidParams();
+        REQUIRE_FALSE((params.checkpoint_save.empty() && params.checkpoint_restore.empty()));
+    }
+}
+
+TEST_CASE("Arg Parser - Warm-up", "[arg_parser][warmup]") {
+    auto [threads, warmup, expectedResult] = GENERATE(
+        std::make_tuple("1", "50000", true),
+        std::make_tuple("4", "50000", true),
+        std::make_tuple("1", "0", true),
+        std::make_tuple("1", "-1", false),
+        std::make_tuple("1", "1234567890", false)
+    );
+
+    char* validInput[] = {
+        (char*)"./cache_test",
+        (char*)"-cache_size",
+        (char*)"small",
+        (char*)"-threads",
+        (char*)threads,
+        (char*)"-policy",
+        (char*)"LRU",
+        (char*)"-assoc",
+        (char*)"4",
+        (char*)"-write_policy",
+        (char*)"WB",
+        (char*)"-trace",
+        (char*)"memory_access.txt",
+        (char*)"-warmup",
+        (char*)warmup
+    };
+    int validInputCount = 15;
+
+    ArgParser argParser(validInputCount, validInput);
+
+    REQUIRE(argParser.validateArguments() == expectedResult);
+    if (expectedResult) {
+        REQUIRE(argParser.getValidParams().warmup_requests == std::stoi(warmup));
+    }
+}
+
+TEST_CASE("Arg Parser - Reuse Distance", "[arg_parser][reuse]") {
+    auto [extraFlag, extraValue, expectedResult] = GENERATE(
+        std::make_tuple("-warmup", "100", true),
+        std::make_tuple("-sweep_assoc", "4,8", false)
+    );
+
+    char* validInput[] = {
+        (char*)"./cache_test",
+        (char*)"-cache_size",
+        (char*)"small",
+        (char*)"-threads",
+        (char*)"1",
+        (char*)"-policy",
+        (char*)"LRU",
+        (char*)"-assoc",
+        (char*)"4",
+        (char*)"-write_policy",
+        (char*)"WB",
+        (char*)"-trace",
+        (char*)"memory_access.txt",
+        (char*)"--reuse_distance",
+        (char*)extraFlag,
+        (char*)extraValue
+    };
+    int validInputCount = 16;
+
+    ArgParser argParser(validInputCount, validInput);
+
+    REQUIRE(argParser.validateArguments() == expectedResult);
+    if (expectedResult) {
+        REQUIRE(argParser.getValidParams().reuse_distance);
+    }
+}
+
+TEST_CASE("Arg Parser - Miss Classification", "[arg_parser][classification]") {
+    auto threads = GENERATE("1", "2");
+
+    char* validInput[] = {
+        (char*)"./cache_test",
+        (char*)"-cache_size",
+        (char*)"small",
+        (char*)"-threads",
+        (char*)threads,
+        (char*)"-policy",
+        (char*)"LRU",
+        (char*)"-assoc",
+        (char*)"4",
+        (char*)"-write_policy",
+        (char*)"WB",
+        (char*)"-trace",
+        (char*)"memory_access.txt",
+        (char*)"--classify_misses"
+    };
+    int validInputCount = 14;
+
+    ArgParser argParser(validInputCount, validInput);
+
+    REQUIRE(argParser.validateArguments());
+    REQUIRE(argParser.getValidParams().classify_misses);
+}
+
+TEST_CASE("Arg Parser - Set Heat Map And Hot Blocks", "[arg_parser][heatmap]") {
+    auto [flag, value, expectedResult] = GENERATE(
+        std::make_tuple("-top_k", "5", true),
+        std::make_tuple("-top_k", "0", false),
+        std::make_tuple("-sweep_assoc", "4,8", false)
+    );
+
+    char* validInput[] = {
+        (char*)"./cache_test",
+        (char*)"-cache_size",
+        (char*)"small",
+        (char*)"-threads",
+        (char*)"1",
+        (char*)"-policy",
+        (char*)"LRU",
+        (char*)"-assoc",
+        (char*)"4",
+        (char*)"-write_policy",
+        (char*)"WB",
+        (char*)"-trace",
+        (char*)"memory_access.txt",
+        (char*)"-set_heatmap",
+        (char*)"sets.csv",
+        (char*)"-hot_blocks",
+        (char*)"blocks.csv",
+        (char*)flag,
+        (char*)value
+    };
+    int validInputCount = 19;
+
+    ArgParser argParser(validInputCount, validInput);
+
+    REQUIRE(argParser.validateArguments() == expectedResult);
+    if (expectedResult) {
+        REQUIRE(argParser.getValidParams().set_heatmap == "sets.csv");
+        REQUIRE(argParser.getValidParams().hot_blocks == "blocks.csv");
+        REQUIRE(argParser.getValidParams().top_k == 5);
+    }
+}
+
+TEST_CASE("Arg Parser - Statistics Files", "[arg_parser][report]") {
+    auto [extraFlag, extraValue, expectedResult] = GENERATE(
+        std::make_tuple("-warmup", "100", true),
+        std::make_tuple("-sweep_assoc", "4,8", false)
+    );
+
+    char* validInput[] = {
+        (char*)"./cache_test",
+        (char*)"-cache_size",
+        (char*)"small",
+        (char*)"-threads",
+        (char*)"2",
+        (char*)"-policy",
+        (char*)"LRU",
+        (char*)"-assoc",
+        (char*)"4",
+        (char*)"-write_policy",
+        (char*)"WB",
+        (char*)"-trace",
+        (char*)"memory_access.txt",
+        (char*)"-stats_json",
+        (char*)"stats.json",
+        (char*)"-stats_csv",
+        (char*)"stats.csv",
+        (char*)extraFlag,
+        (char*)extraValue
+    };
+    int validInputCount = 19;
+
+    ArgParser argParser(validInputCount, validInput);
+
+    REQUIRE(argParser.validateArguments() == expectedResult);
+    if (expectedResult) {
+        REQUIRE(argParser.getValidParams().stats_json == "stats.json");
+        REQUIRE(argParser.getValidParams().stats_csv == "stats.csv");
+    }
+}
+
+TEST_CASE("Arg Parser - Interval Log", "[arg_parser][intervals]") {
+    auto [flag, value, logFile, expectedResult] = GENERATE(
+        std::make_tuple("-interval", "1000", "intervals.csv", true),
+        std::make_tuple("-interval_cycles", "50000", "intervals.csv", true),
+        std::make_tuple("-interval", "0", "intervals.csv", false),
+        std::make_tuple("-interval", "1000", "", false)
+    );
+
+    char* validInput[] = {
+        (char*)"./cache_test",
+        (char*)"-cache_size",
+        (char*)"small",
+        (char*)"-threads",
+        (char*)"2",
+        (char*)"-policy",
+        (char*)"LRU",
+        (char*)"-assoc",
+        (char*)"4",
+        (char*)"-write_policy",
+        (char*)"WB",
+        (char*)"-trace",
+        (char*)"memory_access.txt",
+        (char*)flag,
+        (char*)value,
+        (char*)"-interval_log",
+        (char*)logFile
+    };
+    int validInputCount = 17;
+
+    ArgParser argParser(validInputCount, validInput);
+
+    REQUIRE(argParser.validateArguments() == expectedResult);
+    if (expectedResult) {
+        REQUIRE(argParser.getValidParams().interval_log == "intervals.csv");
+        REQUIRE(argParser.getValidParams().interval_requests + argParser.getValidParams().interval_cycles == std::stoull(value));
+    }
+}
+
+TEST_CASE("Arg Parser - Self Profile", "[arg_parser][self_profile]") {
+    auto threads = GENERATE("1", "4");
+
+    char* validInput[] = {
+        (char*)"./cache_test",
+        (char*)"-cache_size",
+        (char*)"small",
+        (char*)"-threads",
+        (char*)threads,
+        (char*)"-policy",
+        (char*)"LRU",
+        (char*)"-assoc",
+        (char*)"4",
+        (char*)"-write_policy",
+        (char*)"WB",
+        (char*)"-trace",
+        (char*)"memory_access.txt",
+        (char*)"--self_profile"
+    };
+    int validInputCount = 14;
+
+    ArgParser argParser(validInputCount, validInput);
+
+    REQUIRE(argParser.validateArguments());
+    REQUIRE(argParser.getValidParams().self_profile);
+}
+
+TEST_CASE("Arg Parser - Perf Counters Imply Self Profile", "[arg_parser][perf_counters]") {
+    char* validInput[] = {
+        (char*)"./cache_test",
+        (char*)"-cache_size",
+        (char*)"small",
+        (char*)"-threads",
+        (char*)"2",
+        (char*)"-policy",
+        (char*)"LRU",
+        (char*)"-assoc",
+        (char*)"4",
+        (char*)"-write_policy",
+        (char*)"WB",
+        (char*)"-trace",
+        (char*)"memory_access.txt",
+        (char*)"--perf_counters"
+    };
+    int validInputCount = 14;
+
+    ArgParser argParser(validInputCount, validInput);
+
+    REQUIRE(argParser.validateArguments());
+    REQUIRE(argParser.getValidParams().perf_counters);
+    REQUIRE(argParser.getValidParams().self_profile);
+}
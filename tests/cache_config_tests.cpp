@@ -14,4 +14,17 @@ TEST_CASE("Cache Config - All Cache Sizes", "[cache_config]") {
     REQUIRE(config.l1_size == l1);
     REQUIRE(config.l2_size == l2);
     REQUIRE(config.l3_size == l3);
-}
\ No newline at end of file
+}
+TEST_CASE("Cache Config - Explicit Level Sizes", "[cache_config]") {
+    auto [size, expected] = GENERATE(
+        std::make_tuple("49152", 49152),
+        std::make_tuple("48KB", 48 * 1024),
+        std::make_tuple("30MB", 30 * 1024 * 1024),
+        std::make_tuple("0", -1),
+        std::make_tuple("48kb", -1),
+        std::make_tuple("KB", -1),
+        std::make_tuple("-4KB", -1)
+    );
+
+    REQUIRE(parseCacheSize(size) == expected);
+}
@@ -23,6 +23,23 @@ TEST_CASE("Cache Initialization", "[cache]") {
     REQUIRE(cache.getNumSets() == num_sets);
 }
 
+TEST_CASE("Cache Initialization - Block Size", "[cache]") {
+    Memory memory(memorySize, false);
+    CacheStats stats;
+    auto block_size = GENERATE(16, 32, 128, 256);
+    Cache cache(8 * 1024, 4, "LRU", "WB", L1, nullptr, memory, &stats, false, nullptr, block_size);
+
+    int expected_offset_bits = static_cast<int>(log2(block_size));
+    int num_sets = (8 * 1024) / (block_size * 4);
+    REQUIRE(cache.getBlockSize() == block_size);
+    REQUIRE(cache.getOffsetBits() == expected_offset_bits);
+    REQUIRE(cache.getNumSets() == num_sets);
+    REQUIRE(cache.getTagBits() == defaults::ADDRESS_BITS - static_cast<int>(log2(num_sets)) - expected_offset_bits);
+
+    auto bad_block_size = GENERATE(0, 2, 48, 100);
+    REQUIRE_THROWS_AS(Cache(8 * 1024, 4, "LRU", "WB", L1, nullptr, memory, &stats, false, nullptr, bad_block_size), CacheException);
+}
+
 TEST_CASE("Cache - findCacheLine() behavior", "[cache]") {
     Memory memory(memorySize, false);
     CacheStats stats;
@@ -30,7 +47,7 @@ TEST_CASE("Cache - findCacheLine() behavior", "[cache]") {
     Cache cache(8 * 1024, 4, replacementPolicy, "WB", L1, nullptr, memory, &stats);
 
     uint32_t test_address = 0x1000;
-    int expected_tag = test_address >> (cache.getOffsetBits() + cache.getIndexBits());
+    uint64_t expected_tag = test_address >> (cache.getOffsetBits() + cache.getIndexBits());
 
     // should be cache miss
     REQUIRE(cache.findCacheLine(test_address) == nullptr);
@@ -132,6 +149,24 @@ TEST_CASE("Cache - Replacement Policies", "[cache]") {
 
         REQUIRE(cache.findCacheLine(0x2000) == nullptr);
     }
+
+    SECTION("PLRU Replacement") {
+        Cache cache(8 * 1024, 4, "PLRU", "WB", L1, nullptr, memory, &stats);
+
+        // fill the set, the fourth fill marks every line so only 0x4000 stays recent
+        for (auto addr : addresses) {
+            cache.write(addr, 42);
+        }
+        cache.read(0x1000);
+
+        // first line not touched since the reset
+        cache.write(0x5000, 99);
+
+        REQUIRE(cache.findCacheLine(0x2000) == nullptr);
+        REQUIRE(cache.findCacheLine(0x1000) != nullptr);
+        REQUIRE(cache.findCacheLine(0x3000) != nullptr);
+        REQUIRE(cache.findCacheLine(0x4000) != nullptr);
+    }
 }
 
 TEST_CASE("Cache - Write Policy Behavior", "[cache]") {
@@ -499,4 +534,666 @@ TEST_CASE("Cache - Random Access Read/Write to Cache", "[cache][profiling]") {
         REQUIRE_NOTHROW(cache.read(addr));
         REQUIRE(cache.read(addr) == value_map[addr]);
     }
-}
\ No newline at end of file
+}
+TEST_CASE("Inclusion - Inclusive Eviction Back-Invalidates Upper Level", "[cache]") {
+    Memory memory(memorySize, false);
+    CacheStats stats;
+    Cache L2(4 * 1024, 1, "LRU", "WB", Level::L2, nullptr, memory, &stats);
+    Cache L1(8 * 1024, 4, "LRU", "WB", Level::L1, &L2, memory, &stats);
+    L2.setInclusionPolicy("INCLUSIVE");
+
+    uint32_t addr1 = 0x1000;
+    uint32_t addr2 = addr1 + (4 * 1024); // same L2 set, different L1 way
+
+    L1.write(addr1, 42);
+    REQUIRE(L2.findCacheLine(addr1) != nullptr);
+
+    L1.read(addr2); // L2 evicts addr1, L1 must drop it too
+    REQUIRE(L2.findCacheLine(addr1) == nullptr);
+    REQUIRE(L1.findCacheLine(addr1) == nullptr);
+    REQUIRE(stats.back_invalidations == 1);
+
+    // dirty upper-level copy was written back before invalidation
+    REQUIRE(memory.read(addr1) == 42);
+    REQUIRE(L1.read(addr1) == 42);
+}
+
+TEST_CASE("Inclusion - Exclusive Level Holds Only Upper-Level Victims", "[cache]") {
+    Memory memory(memorySize, false);
+    CacheStats stats;
+    Cache L2(8 * 1024, 4, "LRU", "WB", Level::L2, nullptr, memory, &stats);
+    Cache L1(8 * 1024, 1, "LRU", "WB", Level::L1, &L2, memory, &stats);
+    L2.setInclusionPolicy("EXCLUSIVE");
+
+    uint32_t addr1 = 0x1000;
+    uint32_t addr2 = addr1 + (8 * 1024); // conflicts with addr1 in direct-mapped L1
+
+    L1.write(addr1, 42);
+    REQUIRE(L1.findCacheLine(addr1) != nullptr);
+    REQUIRE(L2.findCacheLine(addr1) == nullptr);
+
+    L1.read(addr2); // L1 victim moves into L2
+    REQUIRE(L2.findCacheLine(addr1) != nullptr);
+    REQUIRE(stats.exclusive_fills == 1);
+
+    REQUIRE(L1.read(addr1) == 42); // L2 hit moves the block back up
+    REQUIRE(stats.l2_hits == 1);
+    REQUIRE(L1.findCacheLine(addr1) != nullptr);
+    REQUIRE(L2.findCacheLine(addr1) == nullptr);
+    REQUIRE(L2.findCacheLine(addr2) != nullptr);
+}
+
+TEST_CASE("Inclusion - NINE Keeps Independent Levels", "[cache]") {
+    Memory memory(memorySize, false);
+    CacheStats stats;
+    Cache L2(4 * 1024, 1, "LRU", "WB", Level::L2, nullptr, memory, &stats);
+    Cache L1(8 * 1024, 4, "LRU", "WB", Level::L1, &L2, memory, &stats);
+    REQUIRE(L2.getInclusionPolicy() == "NINE");
+
+    L1.read(0x1000);
+    L1.read(0x1000 + (4 * 1024));
+    REQUIRE(L2.findCacheLine(0x1000) == nullptr);
+    REQUIRE(L1.findCacheLine(0x1000) != nullptr);
+    REQUIRE(stats.back_invalidations == 0);
+}
+
+TEST_CASE("Inclusion - Invalid Policy Should Fail", "[cache]") {
+    Memory memory(memorySize, false);
+    CacheStats stats;
+    Cache cache(8 * 1024, 4, "LRU", "WB", L2, nullptr, memory, &stats);
+    REQUIRE_THROWS_AS(cache.setInclusionPolicy("MOSTLY"), CacheException);
+}
+
+TEST_CASE("Policies - Unknown Names Are Rejected At Construction", "[cache]") {
+    Memory memory(memorySize, false);
+    CacheStats stats;
+    REQUIRE_THROWS_AS(Cache(8 * 1024, 4, "MRU", "WB", L1, nullptr, memory, &stats), CacheException);
+    REQUIRE_THROWS_AS(Cache(8 * 1024, 4, "LRU", "WA", L1, nullptr, memory, &stats), CacheException);
+    Cache cache(8 * 1024, 4, "FIFO", "WT", L1, nullptr, memory, &stats);
+    REQUIRE(cache.getReplacementPolicy() == "FIFO");
+    REQUIRE(cache.getWritePolicy() == "WT");
+}
+
+TEST_CASE("Victim Cache - Absorbs Direct-Mapped Conflict Misses", "[cache][victim_cache]") {
+    Memory memory(memorySize, false);
+    CacheStats stats;
+    Cache cache(8 * 1024, 1, "LRU", "WB", L1, nullptr, memory, &stats);
+    cache.attachVictimCache(4);
+
+    uint32_t addr1 = 0x1000;
+    uint32_t addr2 = addr1 + (8 * 1024); // same set in a direct-mapped cache
+
+    cache.write(addr1, 42);
+    cache.write(addr2, 99); // addr1 moves into the victim cache, still dirty
+    REQUIRE(cache.findCacheLine(addr1) == nullptr);
+    REQUIRE(cache.getVictimCache()->contains(addr1));
+    REQUIRE(memory.read(addr1) == 0);
+
+    REQUIRE(cache.read(addr1) == 42); // swapped back in, addr2 takes its place
+    REQUIRE(stats.victim_hits == 1);
+    REQUIRE(stats.victim_swaps == 1);
+    REQUIRE(cache.findCacheLine(addr1) != nullptr);
+    REQUIRE(cache.getVictimCache()->contains(addr2));
+
+    cache.flushCache();
+    REQUIRE(memory.read(addr2) == 99);
+}
+
+TEST_CASE("Victim Cache - Displaced Dirty Entry Is Written Back", "[cache][victim_cache]") {
+    Memory memory(memorySize, false);
+    CacheStats stats;
+    Cache cache(8 * 1024, 1, "LRU", "WB", L1, nullptr, memory, &stats);
+    cache.attachVictimCache(1);
+
+    cache.write(0x1000, 42);
+    cache.write(0x1000 + (8 * 1024), 1);
+    cache.write(0x1000 + (16 * 1024), 2); // pushes 0x1000 out of the one-entry buffer
+
+    REQUIRE(memory.read(0x1000) == 42);
+    REQUIRE(stats.dirty_evictions == 1);
+}
+
+TEST_CASE("Prefetch - Next-Line Fills Are Not Demand Accesses", "[cache][prefetcher]") {
+    Memory memory(memorySize, false);
+    CacheStats stats;
+    Cache cache(8 * 1024, 4, "LRU", "WB", L1, nullptr, memory, &stats);
+    cache.attachPrefetcher("NEXT_LINE", 2, 0);
+    memory.write(0x1040, 7);
+
+    cache.read(0x1000);
+    REQUIRE(stats.prefetches_issued == 2);
+    REQUIRE(stats.total_operations == 1);
+    REQUIRE(stats.l1_misses == 1);
+    REQUIRE(cache.findCacheLine(0x1040) != nullptr);
+    REQUIRE(cache.findCacheLine(0x1080) != nullptr);
+
+    REQUIRE(cache.read(0x1040) == 7); // demand hit on a prefetched line
+    REQUIRE(stats.l1_hits == 1);
+    REQUIRE(stats.prefetch_useful == 1);
+    REQUIRE(stats.prefetchAccuracy() > 0.0);
+}
+
+TEST_CASE("Prefetch - Late and Unused Prefetches", "[cache][prefetcher]") {
+    Memory memory(memorySize, false);
+    CacheStats stats;
+    Cache cache(8 * 1024, 1, "LRU", "WB", L1, nullptr, memory, &stats);
+    cache.attachPrefetcher("NEXT_LINE", 1, 4);
+
+    cache.read(0x1000); // prefetches 0x1040, lands 4 demand accesses later
+    cache.read(0x1040);
+    REQUIRE(stats.prefetch_useful == 1);
+    REQUIRE(stats.prefetch_late == 1);
+
+    // 0x1080 was prefetched by the tagged hit above, conflict it out before use
+    cache.read(0x1080 + (8 * 1024));
+    REQUIRE(stats.prefetch_unused == 1);
+}
+
+TEST_CASE("Prefetch - Stops At Memory Boundary", "[cache][prefetcher]") {
+    Memory memory(memorySize, false);
+    CacheStats stats;
+    Cache cache(8 * 1024, 4, "LRU", "WB", L1, nullptr, memory, &stats);
+    cache.attachPrefetcher("NEXT_LINE", 4, 0);
+
+    uint32_t last_block = (0x1000 + memorySize) - defaults::BLOCK_SIZE;
+    REQUIRE_NOTHROW(cache.read(last_block));
+    REQUIRE(stats.prefetches_issued == 0);
+}
+
+TEST_CASE("Latency - Hits, Misses and AMAT", "[cache][latency]") {
+    Memory memory(memorySize, false);
+    CacheStats stats;
+    Cache L2(32 * 1024, 4, "LRU", "WB", Level::L2, nullptr, memory, &stats);
+    Cache L1(8 * 1024, 2, "LRU", "WB", Level::L1, &L2, memory, &stats);
+    L1.setLatency(4, 100, 50);
+    L2.setLatency(10, 100, 50);
+
+    L1.read(0x1000); // misses everywhere
+    REQUIRE(L1.getLastAccessCycles() == 4 + 10 + 100);
+
+    L1.read(0x1000); // L1 hit
+    REQUIRE(L1.getLastAccessCycles() == 4);
+
+    REQUIRE(stats.total_cycles == 118);
+    REQUIRE(L1.getTotalCycles() == 118);
+    REQUIRE(stats.averageMemoryAccessTime() == Approx(59.0));
+    REQUIRE(stats.latency_histogram[2] == 1); // [4, 8)
+    REQUIRE(stats.latency_histogram[6] == 1); // [64, 128)
+}
+
+TEST_CASE("Latency - Write Miss Charges Lower Level and Writebacks", "[cache][latency]") {
+    Memory memory(memorySize, false);
+    CacheStats stats;
+    Cache L2(32 * 1024, 4, "LRU", "WB", Level::L2, nullptr, memory, &stats);
+    Cache L1(8 * 1024, 1, "LRU", "WB", Level::L1, &L2, memory, &stats);
+    L1.setLatency(4, 100, 50);
+    L2.setLatency(10, 100, 50);
+
+    L1.read(0x3000); // brings 0x3000 into L2
+    L1.write(0x1000, 1); // write-allocate from memory
+    REQUIRE(L1.getLastAccessCycles() == 4 + 10 + 100);
+
+    L1.write(0x1000 + (8 * 1024), 2); // conflicts with dirty 0x1000, block 0x3000 is in L2
+    REQUIRE(L1.getLastAccessCycles() == 4 + 50 + 10);
+}
+
+TEST_CASE("Latency - Misses and Dirty Evictions Go Through DRAM", "[cache][latency][dram]") {
+    Memory memory(memorySize, false);
+    DramConfig config;
+    config.t_rcd = 10;
+    config.t_cas = 20;
+    config.t_rp = 30;
+    config.t_controller = 0;
+    memory.attachDram(config);
+    CacheStats stats;
+    Cache cache(8 * 1024, 1, "LRU", "WB", L1, nullptr, memory, &stats);
+    cache.setLatency(4, 1000, 1000); // flat latencies are ignored with DRAM attached
+
+    cache.read(0x1000);
+    REQUIRE(cache.getLastAccessCycles() == 4 + 10 + 20); // bank precharged
+
+    cache.write(0x1040, 1); // same row, write-allocate fill
+    REQUIRE(cache.getLastAccessCycles() == 4 + 20);
+
+    // the fill opens a new row in the same bank, then the dirty victim's writeback reopens the old one
+    cache.read(0x1040 + config.row_size * config.banks);
+    REQUIRE(cache.getLastAccessCycles() == 4 + 2 * (30 + 10 + 20));
+    REQUIRE(memory.getDram()->getStats().writes == 1);
+    REQUIRE(memory.getDram()->getStats().row_conflicts == 2);
+}
+
+TEST_CASE("MSHR - Non-Blocking L1 Merges and Overlaps Misses", "[cache][mshr][latency]") {
+    Memory memory(memorySize, false);
+    CacheStats stats;
+    Cache cache(8 * 1024, 4, "LRU", "WB", Level::L1, nullptr, memory, &stats);
+    cache.setLatency(4, 100, 100);
+    cache.attachMshrs(2);
+
+    cache.read(0x1000); // t=0, fill lands at 104
+    REQUIRE(cache.getLastAccessCycles() == 104);
+
+    cache.read(0x1004); // t=4, same block still in flight
+    REQUIRE(cache.getLastAccessCycles() == 100);
+    REQUIRE(stats.mshr_merged == 1);
+
+    cache.read(0x2000); // t=8, second entry, lands at 112
+    REQUIRE(cache.getLastAccessCycles() == 104);
+
+    cache.read(0x3000); // t=12, both entries busy: waits for 0x1000 until 104
+    REQUIRE(cache.getLastAccessCycles() == 4 + 92 + 100);
+    REQUIRE(stats.mshr_allocations == 3);
+    REQUIRE(stats.mshr_full_stalls == 1);
+    REQUIRE(stats.mshr_stall_cycles == 92);
+    REQUIRE(stats.mshr_peak_occupancy == 2);
+
+    // the core only stalled for the full file; the last fill lands at 12 + 196
+    REQUIRE(cache.getTotalCycles() == 208);
+}
+
+TEST_CASE("MSHR - Blocking Cache Without MSHRs", "[cache][mshr][latency]") {
+    Memory memory(memorySize, false);
+    CacheStats stats;
+    Cache cache(8 * 1024, 4, "LRU", "WB", Level::L1, nullptr, memory, &stats);
+    cache.setLatency(4, 100, 100);
+
+    cache.read(0x1000);
+    cache.read(0x1004);
+    cache.read(0x2000);
+    REQUIRE(cache.getTotalCycles() == 104 + 4 + 104);
+    REQUIRE(stats.mshr_merged == 0);
+    REQUIRE(stats.mshr_allocations == 0);
+}
+
+TEST_CASE("Write Buffer - Write-Through Stores Coalesce Before Draining", "[cache][write_buffer]") {
+    Memory memory(memorySize, false);
+    CacheStats stats;
+    Cache cache(8 * 1024, 4, "LRU", "WT", Level::L1, nullptr, memory, &stats);
+    cache.setLatency(4, 100, 100);
+    cache.attachWriteBuffer(2);
+
+    cache.read(0x1000);
+    cache.read(0x2000);
+    cache.read(0x3000);
+    int accesses_before = stats.memory_accesses;
+
+    cache.write(0x1000, 1);
+    cache.write(0x1004, 2);
+    cache.write(0x1000, 3);
+    cache.write(0x2000, 4);
+    REQUIRE(cache.getLastAccessCycles() == 4); // parked in the buffer
+    REQUIRE(stats.write_buffer_coalesced == 2);
+    REQUIRE(stats.memory_accesses == accesses_before); // nothing has left the buffer yet
+    REQUIRE(memory.read(0x1000) == 3); // but memory stays functionally up to date
+
+    cache.write(0x3000, 5); // buffer full, the 0x1000 entry drains first
+    REQUIRE(cache.getLastAccessCycles() == 4 + 100);
+    REQUIRE(stats.write_buffer_full_stalls == 1);
+    REQUIRE(stats.write_buffer_drained_words == 2);
+    REQUIRE(stats.memory_accesses == accesses_before + 2);
+
+    cache.flushCache();
+    REQUIRE(cache.getWriteBuffer()->isEmpty());
+    REQUIRE(stats.write_buffer_drains == 3);
+    REQUIRE(stats.memory_accesses == accesses_before + 4);
+}
+
+TEST_CASE("Write Buffer - Read Miss Drains Stores To Its Block", "[cache][write_buffer]") {
+    Memory memory(memorySize, false);
+    CacheStats stats;
+    Cache L2(32 * 1024, 4, "LRU", "WT", Level::L2, nullptr, memory, &stats);
+    Cache L1(8 * 1024, 1, "LRU", "WT", Level::L1, &L2, memory, &stats);
+    L1.attachWriteBuffer(4, "FULL");
+
+    L1.write(0x1000, 7); // write miss, store buffered
+    L1.read(0x1000 + (8 * 1024)); // evicts the line, buffer untouched
+    REQUIRE(L1.getWriteBuffer()->contains(0x1000));
+
+    REQUIRE(L1.read(0x1000) == 7); // read miss must drain the store before going to L2
+    REQUIRE_FALSE(L1.getWriteBuffer()->contains(0x1000));
+    REQUIRE(stats.write_buffer_drains == 1);
+}
+
+TEST_CASE("Write Buffer - Idle Drain On Loads", "[cache][write_buffer]") {
+    Memory memory(memorySize, false);
+    CacheStats stats;
+    Cache cache(8 * 1024, 4, "LRU", "WT", Level::L1, nullptr, memory, &stats);
+    cache.attachWriteBuffer(4, "IDLE");
+    REQUIRE_THROWS_AS(cache.attachWriteBuffer(4, "LAZY"), CacheException);
+
+    cache.write(0x1000, 1);
+    cache.write(0x2000, 2);
+    cache.read(0x1000);
+    REQUIRE(cache.getWriteBuffer()->getSize() == 1);
+    REQUIRE(stats.write_buffer_drains == 1);
+}
+
+TEST_CASE("Write Allocate - No-Write-Allocate Writes Around The Level", "[cache]") {
+    Memory memory(memorySize, false);
+    CacheStats stats;
+    Cache L2(32 * 1024, 4, "LRU", "WB", Level::L2, nullptr, memory, &stats);
+    Cache L1(8 * 1024, 4, "LRU", "WB", Level::L1, &L2, memory, &stats);
+    L1.setWriteAllocate("NWA");
+    REQUIRE_THROWS_AS(L1.setWriteAllocate("ALLOCATE"), CacheException);
+
+    L1.write(0x1000, 42);
+    REQUIRE(L1.findCacheLine(0x1000) == nullptr); // no line allocated here
+    REQUIRE(L2.findCacheLine(0x1000) != nullptr); // L2 still allocates
+    REQUIRE(memory.read(0x1000) == 42);
+    REQUIRE(stats.l1_misses == 1);
+    REQUIRE(stats.write_arounds == 1);
+    REQUIRE(stats.write_fill_words_saved == defaults::BLOCK_SIZE / sizeof(int));
+
+    REQUIRE(L1.read(0x1000) == 42); // a later read allocates as usual
+    L1.write(0x1004, 7); // write hit is unaffected
+    REQUIRE(L1.findCacheLine(0x1004)->m_dirty);
+    REQUIRE(stats.write_arounds == 1);
+}
+
+TEST_CASE("Write Allocate - Unread Write Fills Count As Pollution", "[cache]") {
+    Memory memory(memorySize, false);
+    CacheStats stats;
+    Cache cache(8 * 1024, 1, "LRU", "WB", Level::L1, nullptr, memory, &stats);
+    REQUIRE(cache.getWriteAllocate() == "WA");
+
+    cache.write(0x1000, 1); // allocated, never read
+    cache.write(0x2000, 2);
+    cache.read(0x2000); // allocated and then read
+    cache.read(0x1000 + (8 * 1024)); // evicts 0x1000
+    cache.read(0x2000 + (8 * 1024)); // evicts 0x2000
+
+    REQUIRE(stats.write_allocate_fills == 2);
+    REQUIRE(stats.write_fills_unread == 1);
+}
+
+TEST_CASE("Block Size - Fill And Writeback Cover The Whole Block", "[cache]") {
+    Memory memory(memorySize, false);
+    CacheStats stats;
+    Cache cache(8 * 1024, 4, "LRU", "WB", L1, nullptr, memory, &stats, false, nullptr, 128);
+    memory.write(0x1078, 11);
+
+    REQUIRE(cache.read(0x1000) == 0); // fills 0x1000 - 0x107f
+    REQUIRE(cache.read(0x1078) == 11);
+    REQUIRE(stats.l1_hits == 1);
+    REQUIRE(stats.memory_accesses == 1 + 128 / sizeof(int)); // the miss request plus the block fill
+
+    cache.write(0x107C, 5);
+    cache.flushCache();
+    REQUIRE(memory.read(0x107C) == 5);
+    REQUIRE(stats.memory_accesses == 1 + 2 * (128 / sizeof(int)));
+}
+
+TEST_CASE("Block Size - Inclusive Level With Larger Blocks Invalidates Every Upper Piece", "[cache]") {
+    Memory memory(memorySize, false);
+    CacheStats stats;
+    Cache L2(16 * 1024, 1, "LRU", "WB", Level::L2, nullptr, memory, &stats, false, nullptr, 128);
+    Cache L1(8 * 1024, 4, "LRU", "WB", Level::L1, &L2, memory, &stats, false, nullptr, 64);
+    L2.setInclusionPolicy("INCLUSIVE");
+
+    L1.read(0x1000);
+    L1.write(0x1040, 9); // second half of the same L2 block, dirty in L1
+    REQUIRE(L1.findCacheLine(0x1000) != nullptr);
+    REQUIRE(L1.findCacheLine(0x1040) != nullptr);
+
+    L1.read(0x1000 + (16 * 1024)); // conflicts with 0x1000 in the direct-mapped L2
+    REQUIRE(L1.findCacheLine(0x1000) == nullptr);
+    REQUIRE(L1.findCacheLine(0x1040) == nullptr);
+    REQUIRE(stats.back_invalidations == 2);
+    REQUIRE(memory.read(0x1040) == 9);
+}
+
+TEST_CASE("Cache - 64-bit Addresses Keep Their Upper Bits", "[cache]") {
+    Memory memory(memorySize, false, true);
+    CacheStats stats;
+    Cache cache(8 * 1024, 4, "LRU", "WB", L1, nullptr, memory, &stats);
+    uint64_t low = 0x00007f0000001000ULL;
+    uint64_t high = 0x00017f0000001000ULL; // same index and low 32 bits, differs above bit 32
+
+    cache.write(low, 1);
+    cache.write(high, 2);
+    REQUIRE(cache.read(low) == 1);
+    REQUIRE(cache.read(high) == 2);
+    REQUIRE(cache.findCacheLine(low)->m_tag != cache.findCacheLine(high)->m_tag);
+    REQUIRE(cache.getTagBits() == 64 - cache.getIndexBits() - cache.getOffsetBits());
+
+    cache.flushCache();
+    REQUIRE(memory.read(high) == 2);
+    REQUIRE(memory.read(low) == 1);
+}
+
+TEST_CASE("Geometry - Non Power Of Two Set Count", "[cache]") {
+    Memory memory(memorySize, false);
+    CacheStats stats;
+    Cache cache(48 * 1024, 8, "LRU", "WB", L1, nullptr, memory, &stats); // 96 sets
+    REQUIRE(cache.getNumSets() == 96);
+    REQUIRE(cache.getIndexBits() == 7);
+    uint64_t stride = 96 * 64; // same set, consecutive tags
+
+    for (int i = 0; i < 8; i++) {
+        cache.write(0x1000 + i * stride, i + 1);
+    }
+    REQUIRE(cache.read(0x1000 + 7 * stride) == 8);
+    REQUIRE(stats.l1_hits == 1);
+    cache.read(0x1000 + 8 * stride); // ninth block in the set evicts the LRU one
+    REQUIRE(cache.findCacheLine(0x1000) == nullptr);
+    REQUIRE(memory.read(0x1000) == 1); // written back to the address it came from
+
+    cache.flushCache();
+    for (int i = 1; i < 8; i++) {
+        REQUIRE(memory.read(0x1000 + i * stride) == i + 1);
+    }
+}
+
+TEST_CASE("Geometry - Size Must Divide Into Whole Sets", "[cache]") {
+    Memory memory(memorySize, false);
+    CacheStats stats;
+    REQUIRE_THROWS_AS(Cache(10000, 4, "LRU", "WB", L1, nullptr, memory, &stats), CacheException);
+    REQUIRE_THROWS_AS(Cache(64 * 3, 4, "LRU", "WB", L1, nullptr, memory, &stats), CacheException);
+    REQUIRE_NOTHROW(Cache(40 * 1024, 20, "LRU", "WB", L1, nullptr, memory, &stats));
+}
+
+TEST_CASE("Mixed Hierarchy - Per Level Policies", "[cache]") {
+    Memory memory(memorySize, false);
+    CacheStats stats;
+    Cache L2(64 * 1024, 8, "LRU", "WB", Level::L2, nullptr, memory, &stats);
+    Cache L1(8 * 1024, 4, "PLRU", "WT", Level::L1, &L2, memory, &stats);
+    REQUIRE(L1.getReplacementPolicy() == "PLRU");
+    REQUIRE(L1.getWritePolicy() == "WT");
+    REQUIRE(L2.getWritePolicy() == "WB");
+
+    L1.write(0x1000, 7); // written through L1 into the write-back L2
+    REQUIRE_FALSE(L1.findCacheLine(0x1000)->m_dirty);
+    REQUIRE(L2.findCacheLine(0x1000)->m_dirty);
+    REQUIRE(L1.read(0x1000) == 7);
+
+    L1.flushCache();
+    L2.flushCache();
+    REQUIRE(memory.read(0x1000) == 7);
+    REQUIRE_FALSE(L2.findCacheLine(0x1000)->m_dirty);
+}
+
+TEST_CASE("Set Sampling - Unsampled L3 Sets Are Skipped", "[cache][sampling]") {
+    Memory memory(memorySize, false);
+    CacheStats stats;
+    Cache L3(64 * 1024, 4, "LRU", "WB", Level::L3, nullptr, memory, &stats); // 256 sets
+    L3.setSetSampling(4);
+    REQUIRE(stats.l3_sample_accesses.size() == 64);
+    REQUIRE_THROWS_AS(Cache(8 * 1024, 4, "LRU", "WB", L1, nullptr, memory, &stats).setSetSampling(4), CacheException);
+
+    memory.write(0x1040, 3);
+    REQUIRE(L3.read(0x1000) == 0); // set 64, sampled
+    REQUIRE(L3.read(0x1040) == 3); // set 65, served from memory without touching the cache
+    REQUIRE(L3.findCacheLine(0x1000) != nullptr);
+    REQUIRE(L3.findCacheLine(0x1040) == nullptr);
+    L3.read(0x1000);
+    REQUIRE(stats.l3_misses == 1);
+    REQUIRE(stats.l3_hits == 1);
+    REQUIRE(stats.l3_skipped_accesses == 1);
+    REQUIRE(stats.l3_sample_accesses[16] == 2);
+    REQUIRE(stats.l3_sample_misses[16] == 1);
+    REQUIRE(stats.extrapolatedL3Misses() == 4);
+}
+
+TEST_CASE("Set Sampling - Filtering Before L1 Keeps Sampled Sets Exact", "[cache][sampling]") {
+    auto run = [](bool filter, CacheStats& stats, Memory& memory) {
+        Cache L3(256 * 1024, 8, "LRU", "WB", Level::L3, nullptr, memory, &stats);
+        Cache L2(64 * 1024, 4, "LRU", "WB", Level::L2, &L3, memory, &stats);
+        Cache L1(8 * 1024, 4, "LRU", "WB", Level::L1, &L2, memory, &stats);
+        L3.setSetSampling(8);
+        if (filter) L1.enableSampleFilter();
+        for (int i = 0; i < 20000; i++) {
+            uint64_t address = 0x1000 + ((static_cast<uint64_t>(i) * 7 * 64 + (i % 5) * 4) % (2 * 1024 * 1024));
+            if (i % 4 == 0) {
+                L1.write(address, i);
+            } else {
+                L1.read(address);
+            }
+        }
+        L1.flushCache();
+        L2.flushCache();
+        L3.flushCache();
+    };
+
+    Memory full_memory(memorySize, false);
+    Memory filtered_memory(memorySize, false);
+    CacheStats full, filtered;
+    run(false, full, full_memory);
+    run(true, filtered, filtered_memory);
+
+    REQUIRE(filtered.l3_filtered_requests > 0);
+    REQUIRE(filtered.total_operations < full.total_operations);
+    REQUIRE(filtered.l3_misses == full.l3_misses);
+    REQUIRE(filtered.l3_sample_misses == full.l3_sample_misses);
+    int mismatches = 0; // filtered stores went straight to memory
+    for (uint64_t address = 0x1000; address < 0x1000 + 2 * 1024 * 1024; address += 4) {
+        mismatches += filtered_memory.read(address) != full_memory.read(address);
+    }
+    REQUIRE(mismatches == 0);
+}
+
+TEST_CASE("Set Sampling - Confidence Interval", "[cache][sampling]") {
+    CacheStats stats;
+    stats.l3_total_sets = 1024;
+    stats.l3_sample_accesses = {100, 100, 100, 100};
+    stats.l3_sample_misses = {10, 20, 30, 40};
+    REQUIRE(stats.sampledL3MissRate() == Approx(25.0));
+    // residuals 15, 5, 5, 15 -> s^2 = 500 / 3, variance = (1 - 4/1024) * s^2 / (4 * 100^2)
+    REQUIRE(stats.sampledL3MissRateError() == Approx(100.0 * 1.96 * std::sqrt((1020.0 / 1024.0) * (500.0 / 3.0) / 40000.0)));
+
+    stats.l3_sample_misses = {25, 25, 25, 25};
+    REQUIRE(stats.sampledL3MissRateError() == Approx(0.0));
+}
+
+TEST_CASE("Functional Warming - Tags Without Stats Or Data", "[cache][sampling]") {
+    Memory memory(memorySize, false);
+    CacheStats stats;
+    Cache L2(64 * 1024, 4, "LRU", "WB", Level::L2, nullptr, memory, &stats);
+    Cache L1(8 * 1024, 4, "LRU", "WB", Level::L1, &L2, memory, &stats);
+    memory.write(0x1004, 9);
+
+    L1.warm(0x1000, false);
+    L1.warm(0x2040, true, 5); // write miss, dirty in L1 but memory holds the value
+    REQUIRE(stats.total_operations == 0);
+    REQUIRE(stats.l1_misses == 0);
+    REQUIRE(stats.memory_accesses == 0);
+    REQUIRE(L1.getTotalCycles() == 0);
+    REQUIRE(memory.read(0x2040) == 5);
+
+    REQUIRE(L1.read(0x1004) == 9); // warmed tag hits, its data is fetched on first use
+    REQUIRE(stats.l1_hits == 1);
+    REQUIRE(L2.findCacheLine(0x1000) != nullptr);
+    REQUIRE(L2.findCacheLine(0x2040) == nullptr); // NINE levels are not filled by write misses
+
+    CacheLine* dirty = L1.findCacheLine(0x2040);
+    REQUIRE(dirty != nullptr);
+    REQUIRE(dirty->m_dirty);
+    REQUIRE(dirty->m_data[0] == 5);
+    L1.write(0x2044, 6);
+    L1.flushCache();
+    REQUIRE(memory.read(0x2040) == 5);
+    REQUIRE(memory.read(0x2044) == 6);
+}
+
+TEST_CASE("Functional Warming - Leaves The State Of A Detailed Run", "[cache][sampling]") {
+    std::string inclusion = GENERATE(std::string("INCLUSIVE"), std::string("EXCLUSIVE"));
+    Memory detailed_memory(memorySize, false);
+    Memory warmed_memory(memorySize, false);
+    CacheStats detailed_stats;
+    CacheStats warmed_stats;
+    Cache detailed_L2(4 * 1024, 2, "LRU", "WB", Level::L2, nullptr, detailed_memory, &detailed_stats);
+    Cache detailed_L1(1024, 2, "LRU", "WB", Level::L1, &detailed_L2, detailed_memory, &detailed_stats);
+    Cache warmed_L2(4 * 1024, 2, "LRU", "WB", Level::L2, nullptr, warmed_memory, &warmed_stats);
+    Cache warmed_L1(1024, 2, "LRU", "WB", Level::L1, &warmed_L2, warmed_memory, &warmed_stats);
+    detailed_L2.setInclusionPolicy(inclusion);
+    warmed_L2.setInclusionPolicy(inclusion);
+
+    const uint64_t blocks = 256; // 16 KB, four times the L2
+    uint32_t seed = 12345;
+    for (int i = 0; i < 4000; i++) {
+        seed = seed * 1103515245 + 12345;
+        uint64_t address = 0x1000 + ((seed >> 8) % blocks) * 64 + ((seed >> 4) % 16) * 4;
+        bool is_write = (seed >> 24) % 3 == 0;
+        if (is_write) {
+            detailed_L1.write(address, i);
+        } else {
+            detailed_L1.read(address);
+        }
+        warmed_L1.warm(address, is_write, i);
+    }
+
+    if (inclusion == "INCLUSIVE") {
+        REQUIRE(detailed_stats.back_invalidations > 0);
+    } else {
+        REQUIRE(detailed_stats.exclusive_fills > 0);
+    }
+    REQUIRE(warmed_stats.evictions == 0);
+    REQUIRE(warmed_stats.back_invalidations == 0);
+    REQUIRE(warmed_stats.exclusive_fills == 0);
+    REQUIRE(warmed_stats.memory_accesses == 0);
+    REQUIRE(warmed_L1.getTotalCycles() == 0);
+
+    for (uint64_t block = 0; block < blocks; block++) {
+        uint64_t address = 0x1000 + block * 64;
+        CacheLine* detailed_line = detailed_L1.findCacheLine(address);
+        CacheLine* warmed_line = warmed_L1.findCacheLine(address);
+        REQUIRE((detailed_line == nullptr) == (warmed_line == nullptr));
+        if (detailed_line != nullptr) {
+            REQUIRE(detailed_line->m_dirty == warmed_line->m_dirty);
+        }
+        CacheLine* detailed_below = detailed_L2.findCacheLine(address);
+        CacheLine* warmed_below = warmed_L2.findCacheLine(address);
+        REQUIRE((detailed_below == nullptr) == (warmed_below == nullptr));
+        if (inclusion == "INCLUSIVE" && warmed_line != nullptr) {
+            REQUIRE(warmed_below != nullptr);
+        } else if (inclusion == "EXCLUSIVE" && warmed_line != nullptr) {
+            REQUIRE(warmed_below == nullptr);
+        }
+    }
+
+    detailed_L1.flushCache();
+    detailed_L2.flushCache();
+    warmed_L1.flushCache();
+    warmed_L2.flushCache();
+    for (uint64_t word = 0; word < blocks * 16; word++) {
+        REQUIRE(detailed_memory.read(0x1000 + word * 4) == warmed_memory.read(0x1000 + word * 4));
+    }
+}
+
+TEST_CASE("Functional Warming - Skips Sets The L3 Does Not Sample", "[cache][sampling]") {
+    Memory memory(memorySize, false);
+    CacheStats stats;
+    Cache L3(64 * 1024, 4, "LRU", "WB", Level::L3, nullptr, memory, &stats); // 256 sets
+    Cache L2(16 * 1024, 4, "LRU", "WB", Level::L2, &L3, memory, &stats);
+    Cache L1(4 * 1024, 4, "LRU", "WB", Level::L1, &L2, memory, &stats);
+    L3.setSetSampling(4);
+    L1.enableSampleFilter();
+
+    L1.warm(0x1000, false); // L3 set 64, sampled
+    L1.warm(0x1040, true, 3); // L3 set 65, outside the sample
+    REQUIRE(L1.findCacheLine(0x1000) != nullptr);
+    REQUIRE(L3.findCacheLine(0x1000) != nullptr);
+    REQUIRE(L1.findCacheLine(0x1040) == nullptr);
+    REQUIRE(L2.findCacheLine(0x1040) == nullptr);
+    REQUIRE(L3.findCacheLine(0x1040) == nullptr);
+    REQUIRE(memory.read(0x1040) == 3);
+    REQUIRE(stats.l3_filtered_requests == 0);
+}
@@ -0,0 +1,257 @@
+#include "../catch2/catch.hpp"
+#include "../src/threading/core_hierarchy.h"
+#include <filesystem>
+#include <fstream>
+
+static ValidParams hierarchyParams() {
+    ValidParams params;
+    params.l1_cache_size = 8 * 1024;
+    params.l2_cache_size = 64 * 1024;
+    params.l3_cache_size = 256 * 1024;
+    params.memory_size = "small";
+    params.num_threads = 1;
+    params.replacement_policy = "LRU";
+    params.write_policy = "WB";
+    params.access_file_name = "valid_file.txt";
+    params.isVerbose = false;
+    params.associativity = 4;
+    params.l1_associativity = params.l2_associativity = params.l3_associativity = params.associativity;
+    params.l1_replacement_policy = params.l2_replacement_policy = params.l3_replacement_policy = params.replacement_policy;
+    params.l1_write_policy = params.l2_write_policy = params.l3_write_policy = params.write_policy;
+    return params;
+}
+
+static std::vector<MemoryRequest> hierarchyTrace() {
+    std::vector<MemoryRequest> requests;
+    for (uint64_t i = 0; i < 10000; i++) {
+        uint64_t address = 0x1000 + ((i * 4164) % (1024 * 1024)) / 4 * 4;
+        requests.emplace_back(i % 3 == 0 ? AccessType::WRITE : AccessType::READ, address, static_cast<int>(i));
+    }
+    return requests;
+}
+
+TEST_CASE("Core Hierarchy - Time Sampling Alternates Warming And Detailed Units", "[sampling]") {
+    ValidParams params = hierarchyParams();
+    params.time_sample_period = 1000;
+    params.time_sample_unit = 200;
+    std::vector<MemoryRequest> requests = hierarchyTrace();
+
+    Memory sampled_memory(4 * 1024 * 1024, false);
+    CacheStats sampled;
+    CoreHierarchy hierarchy(params, sampled_memory, &sampled);
+    for (const MemoryRequest& request : requests) {
+        hierarchy.access(request);
+    }
+    hierarchy.finish();
+
+    REQUIRE(sampled.sample_units.size() == 10);
+    REQUIRE(sampled.warmed_requests == 8000);
+    REQUIRE(sampled.total_operations == 2000);
+    for (const SampleUnit& unit : sampled.sample_units) {
+        REQUIRE(unit.operations == 200);
+        REQUIRE(unit.cycles > 0);
+    }
+
+    // warming never loses a store: memory ends up as after a full detailed run
+    Memory full_memory(4 * 1024 * 1024, false);
+    CacheStats full;
+    CoreHierarchy reference(hierarchyParams(), full_memory, &full);
+    for (const MemoryRequest& request : requests) {
+        reference.access(request);
+    }
+    reference.finish();
+    int mismatches = 0;
+    for (uint64_t address = 0x1000; address < 0x1000 + 1024 * 1024; address += 4) {
+        mismatches += sampled_memory.read(address) != full_memory.read(address);
+    }
+    REQUIRE(mismatches == 0);
+
+    auto l1 = sampled.sampledRate([](const SampleUnit& unit) { return unit.l1_misses; });
+    double full_rate = static_cast<double>(full.l1_misses) / full.total_operations;
+    REQUIRE(std::abs(l1.first - full_rate) <= l1.second + 0.02);
+}
+
+TEST_CASE("Core Hierarchy - Sampled Rate And Error Bound", "[sampling]") {
+    CacheStats stats;
+    for (uint64_t misses : {10, 20, 30, 40}) {
+        SampleUnit unit;
+        unit.operations = 100;
+        unit.l1_misses = misses;
+        stats.sample_units.push_back(unit);
+    }
+    auto rate = stats.sampledRate([](const SampleUnit& unit) { return unit.l1_misses; });
+    REQUIRE(rate.first == Approx(0.25));
+    // sample variance of 0.1, 0.2, 0.3, 0.4 is 1/60
+    REQUIRE(rate.second == Approx(1.96 * std::sqrt((1.0 / 60.0) / 4)));
+
+    ValidParams params = hierarchyParams();
+    Memory memory(4 * 1024 * 1024, false);
+    CoreHierarchy hierarchy(params, memory, &stats);
+    REQUIRE_THROWS_AS(hierarchy.setTimeSampling(100, 200), CacheException);
+}
+
+static std::string checkpointPath() {
+    return (std::filesystem::temp_directory_path() / "core_hierarchy_test.ckpt").string();
+}
+
+TEST_CASE("Core Hierarchy - Checkpoint Resumes Where The Run Left Off", "[checkpoint]") {
+    ValidParams params = hierarchyParams();
+    params.victim_cache_entries = 8;
+    params.l2_write_policy = "WT";
+    params.write_buffer_entries = 4;
+    std::vector<MemoryRequest> requests = hierarchyTrace();
+    const size_t split = requests.size() / 2;
+
+    // warm the first half with time sampling so warmed lines without data end up in the checkpoint
+    ValidParams warm_params = params;
+    warm_params.time_sample_period = 1000;
+    warm_params.time_sample_unit = 100;
+    Memory memory(4 * 1024 * 1024, false);
+    CacheStats warm_stats;
+    CoreHierarchy hierarchy(warm_params, memory, &warm_stats);
+    for (size_t i = 0; i < split; i++) {
+        hierarchy.access(requests[i]);
+    }
+    hierarchy.saveCheckpoint(checkpointPath(), split);
+
+    // the original keeps going in detail, the restored copy must behave the same from here on
+    hierarchy.setTimeSampling(1, 1);
+    CacheStats restored_stats;
+    Memory restored_memory(4 * 1024 * 1024, false);
+    CoreHierarchy restored(params, restored_memory, &restored_stats);
+    REQUIRE(restored.restoreCheckpoint(checkpointPath()) == split);
+
+    int before = warm_stats.l1_misses;
+    for (size_t i = split; i < requests.size(); i++) {
+        hierarchy.access(requests[i]);
+        restored.access(requests[i]);
+    }
+    hierarchy.finish();
+    restored.finish();
+    REQUIRE(restored_stats.l1_misses == warm_stats.l1_misses - before);
+    REQUIRE(restored_stats.l1_misses > 0);
+
+    int mismatches = 0;
+    for (uint64_t address = 0x1000; address < 0x1000 + 1024 * 1024; address += 4) {
+        mismatches += memory.read(address) != restored_memory.read(address);
+    }
+    REQUIRE(mismatches == 0);
+    std::filesystem::remove(checkpointPath());
+}
+
+TEST_CASE("Core Hierarchy - Checkpoint Rejects A Different Geometry", "[checkpoint]") {
+    ValidParams params = hierarchyParams();
+    Memory memory(4 * 1024 * 1024, false);
+    CacheStats stats;
+    CoreHierarchy hierarchy(params, memory, &stats);
+    hierarchy.access(MemoryRequest(AccessType::WRITE, 0x1000, 5));
+    hierarchy.saveCheckpoint(checkpointPath(), 1);
+
+    ValidParams other = hierarchyParams();
+    other.l2_associativity = 8;
+    CoreHierarchy different(other, memory, &stats);
+    REQUIRE_THROWS_AS(different.restoreCheckpoint(checkpointPath()), CacheException);
+
+    std::ofstream(checkpointPath(), std::ios::binary) << "not a checkpoint";
+    CoreHierarchy same(params, memory, &stats);
+    REQUIRE_THROWS_AS(same.restoreCheckpoint(checkpointPath()), CacheException);
+    REQUIRE_THROWS_AS(same.restoreCheckpoint(checkpointPath() + ".missing"), CacheException);
+    std::filesystem::remove(checkpointPath());
+}
+
+TEST_CASE("Core Hierarchy - Warm-up Requests Are Excluded From The Statistics", "[warmup]") {
+    std::vector<MemoryRequest> requests = hierarchyTrace();
+    const size_t warmup = 4000;
+
+    Memory full_memory(4 * 1024 * 1024, false);
+    CacheStats full;
+    CacheStats at_warmup_end;
+    CoreHierarchy reference(hierarchyParams(), full_memory, &full);
+    for (size_t i = 0; i < requests.size(); i++) {
+        if (i == warmup) at_warmup_end = full;
+        reference.access(requests[i]);
+    }
+    reference.finish();
+
+    ValidParams params = hierarchyParams();
+    params.warmup_requests = warmup;
+    Memory memory(4 * 1024 * 1024, false);
+    CacheStats stats;
+    CoreHierarchy hierarchy(params, memory, &stats);
+    for (const MemoryRequest& request : requests) {
+        hierarchy.access(request);
+    }
+    hierarchy.finish();
+
+    REQUIRE(stats.warmup_requests == warmup);
+    REQUIRE(stats.total_operations == static_cast<int>(requests.size() - warmup));
+    REQUIRE(stats.l1_misses == full.l1_misses - at_warmup_end.l1_misses);
+    REQUIRE(stats.l2_misses == full.l2_misses - at_warmup_end.l2_misses);
+    REQUIRE(stats.l3_misses == full.l3_misses - at_warmup_end.l3_misses);
+    REQUIRE(stats.total_cycles == full.total_cycles - at_warmup_end.total_cycles);
+    REQUIRE(stats.core_cycles[0] == full.core_cycles[0] - at_warmup_end.total_cycles);
+}
+
+TEST_CASE("Core Hierarchy - Trace Ending Inside The Warm-up Measures Nothing", "[warmup]") {
+    ValidParams params = hierarchyParams();
+    params.warmup_requests = 100;
+    Memory memory(4 * 1024 * 1024, false);
+    CacheStats stats;
+    CoreHierarchy hierarchy(params, memory, &stats);
+    for (int i = 0; i < 50; i++) {
+        hierarchy.access(MemoryRequest(AccessType::WRITE, 0x1000 + 64 * i, i));
+    }
+    hierarchy.finish();
+
+    REQUIRE(stats.warmup_requests == 50);
+    REQUIRE(stats.total_operations == 0);
+    REQUIRE(stats.l1_misses == 0);
+    REQUIRE(stats.core_cycles[0] == 0);
+    REQUIRE(memory.read(0x1000 + 64 * 49) == 49); // the warm-up still simulated the stores
+}
+
+TEST_CASE("Cache Stats - Reset Keeps The Sampling Layout", "[warmup]") {
+    CacheStats stats;
+    stats.l3_sample_ratio = 4;
+    stats.l3_total_sets = 64;
+    stats.l3_sample_accesses = {3, 5};
+    stats.l3_sample_misses = {1, 2};
+    stats.time_sample_period = 1000;
+    stats.sample_units.push_back(SampleUnit());
+    stats.l1_misses = 10;
+    stats.total_cycles = 500;
+    stats.latency_histogram[3] = 7;
+    stats.warmup_requests = 20;
+
+    stats.resetCounters();
+    REQUIRE(stats.l1_misses == 0);
+    REQUIRE(stats.total_cycles == 0);
+    REQUIRE(stats.latency_histogram[3] == 0);
+    REQUIRE(stats.sample_units.empty());
+    REQUIRE(stats.l3_sample_ratio == 4);
+    REQUIRE(stats.l3_total_sets == 64);
+    REQUIRE(stats.l3_sample_accesses == std::vector<uint64_t>{0, 0});
+    REQUIRE(stats.l3_sample_misses == std::vector<uint64_t>{0, 0});
+    REQUIRE(stats.time_sample_period == 1000);
+    REQUIRE(stats.warmup_requests == 20);
+}
+
+TEST_CASE("Core Hierarchy - Reuse Profile Follows The Warm-up", "[reuse][warmup]") {
+    ValidParams params = hierarchyParams();
+    params.warmup_requests = 1000;
+    std::vector<MemoryRequest> requests = hierarchyTrace();
+    Memory memory(4 * 1024 * 1024, false);
+    CacheStats stats;
+    ReuseProfiler profiler(params.l1_block_size);
+    CoreHierarchy hierarchy(params, memory, &stats);
+    hierarchy.attachReuseProfiler(&profiler);
+    for (const MemoryRequest& request : requests) {
+        hierarchy.access(request);
+    }
+    hierarchy.finish();
+
+    REQUIRE(profiler.getAccesses() == requests.size() - 1000);
+    uint64_t counted = profiler.getColdAccesses();
+    for (uint64_t count : profiler.getStackHistogram()) counted += count;
+    REQUIRE(counted == profiler.getAccesses());
+}
@@ -24,6 +24,9 @@ TEST_CASE("Core Manager - Correct Number of Caches", "[core_manager]") {
     params.access_file_name = "valid_file.txt";
     params.isVerbose = false;
     params.associativity = 1;
+    params.l1_associativity = params.l2_associativity = params.l3_associativity = params.associativity;
+    params.l1_replacement_policy = params.l2_replacement_policy = params.l3_replacement_policy = params.replacement_policy;
+    params.l1_write_policy = params.l2_write_policy = params.l3_write_policy = params.write_policy;
 
     Memory memory(memorySize, params.isVerbose);
     FileManager fm(params.access_file_name, params.isVerbose, true);
@@ -35,4 +38,83 @@ TEST_CASE("Core Manager - Correct Number of Caches", "[core_manager]") {
     REQUIRE(coreManager.getNumL1Caches() == expectedL1Size);
     REQUIRE(coreManager.getNumL2Caches() == expectedL2Size);
     REQUIRE(coreManager.getNumL3Caches() == expectedL3Size);
-}
\ No newline at end of file
+}
+TEST_CASE("Core Manager - Warm-up Requests Are Excluded From The Statistics", "[core_manager][warmup]") {
+    ValidParams params;
+    params.l1_cache_size = 16 * 1024;
+    params.l2_cache_size = 64 * 1024;
+    params.l3_cache_size = 512 * 1024;
+    params.memory_size = "medium";
+    params.num_threads = 2;
+    params.replacement_policy = "LRU";
+    params.write_policy = "WB";
+    params.access_file_name = "valid_file.txt";
+    params.isVerbose = false;
+    params.associativity = 4;
+    params.l1_associativity = params.l2_associativity = params.l3_associativity = params.associativity;
+    params.l1_replacement_policy = params.l2_replacement_policy = params.l3_replacement_policy = params.replacement_policy;
+    params.l1_write_policy = params.l2_write_policy = params.l3_write_policy = params.write_policy;
+    params.warmup_requests = 5;
+
+    Memory memory(memorySize, params.isVerbose);
+    FileManager fm(params.access_file_name, params.isVerbose, true);
+    fm.parseFile();
+    CacheStats stats;
+    CoreManager coreManager(params.num_threads, &params, &fm, memory, params.isVerbose, &stats);
+    coreManager.startSimulation();
+
+    REQUIRE(stats.warmup_requests == 5);
+    REQUIRE(stats.total_operations == 15);
+    REQUIRE(stats.core_cycles.size() == 2);
+    REQUIRE(stats.total_cycles <= stats.core_cycles[0] + stats.core_cycles[1]);
+}
+
+TEST_CASE("Core Manager - A Write Invalidates Copies In Other Victim Caches", "[core_manager][victim_cache]") {
+    ValidParams params;
+    params.l1_cache_size = 16 * 1024;
+    params.l2_cache_size = 64 * 1024;
+    params.l3_cache_size = 512 * 1024;
+    params.memory_size = "medium";
+    params.num_threads = 2;
+    params.replacement_policy = "LRU";
+    params.write_policy = "WB";
+    params.access_file_name = "valid_file.txt";
+    params.isVerbose = false;
+    params.associativity = 1;
+    params.l1_associativity = params.l2_associativity = params.l3_associativity = params.associativity;
+    params.l1_replacement_policy = params.l2_replacement_policy = params.l3_replacement_policy = params.replacement_policy;
+    params.l1_write_policy = params.l2_write_policy = params.l3_write_policy = params.write_policy;
+    params.victim_cache_entries = 4;
+
+    Memory memory(memorySize, params.isVerbose);
+    FileManager fm(params.access_file_name, params.isVerbose, true);
+    CacheStats stats;
+    CoreManager coreManager(params.num_threads, &params, &fm, memory, params.isVerbose, &stats);
+    Cache* core0 = coreManager.getL1Cache(0);
+    Cache* core1 = coreManager.getL1Cache(1);
+
+    auto [holder_writes, expected_writebacks] = GENERATE(
+        std::make_tuple(true, 1),  // the parked copy is dirty
+        std::make_tuple(false, 0)  // the parked copy is clean
+    );
+    if (holder_writes) {
+        core0->write(0x2000, 7);
+    } else {
+        core0->read(0x2000);
+    }
+    core0->read(0x2000 + 16 * 1024); // same direct-mapped set, 0x2000 moves to core 0's victim cache
+    REQUIRE(core0->findCacheLine(0x2000) == nullptr);
+    REQUIRE(core0->getVictimCache()->contains(0x2000));
+
+    core1->write(0x2000, 9);
+    REQUIRE_FALSE(core0->getVictimCache()->contains(0x2000));
+    REQUIRE(stats.coherence_invalidations == 1);
+    REQUIRE(stats.coherence_writebacks == static_cast<uint64_t>(expected_writebacks));
+    if (holder_writes) {
+        REQUIRE(memory.read(0x2000) == 7); // the dirty data was written back before it was dropped
+    }
+
+    int victim_hits = stats.victim_hits;
+    core0->read(0x2000); // misses to the next level instead of swapping the stale copy back in
+    REQUIRE(stats.victim_hits == victim_hits);
+}
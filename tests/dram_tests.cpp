@@ -0,0 +1,73 @@
+#include "../catch2/catch.hpp"
+#include "../src/memory/dram.h"
+#include "../src/exception/cache_exception.h"
+
+TEST_CASE("DRAM - Address Decoding", "[dram]") {
+    DramConfig config;
+    config.channels = 2;
+    config.ranks = 2;
+    config.banks = 4;
+    config.row_size = 1024; // 16 blocks per row
+    DramModel dram(config);
+
+    // consecutive blocks alternate channels first
+    REQUIRE(dram.decode(0x0000).channel == 0);
+    REQUIRE(dram.decode(0x0040).channel == 1);
+    REQUIRE(dram.decode(0x0080).column == 1);
+
+    // 2 channels * 16 columns = 32 blocks before the bank changes
+    DramAddress next_bank = dram.decode(32 * 64);
+    REQUIRE(next_bank.bank == 1);
+    REQUIRE(next_bank.row == 0);
+
+    DramAddress next_rank = dram.decode(32 * 64 * 4);
+    REQUIRE(next_rank.rank == 1);
+    REQUIRE(next_rank.bank == 0);
+
+    DramAddress next_row = dram.decode(32 * 64 * 4 * 2);
+    REQUIRE(next_row.row == 1);
+    REQUIRE(next_row.rank == 0);
+}
+
+TEST_CASE("DRAM - Open Page Row Buffer Timing", "[dram]") {
+    DramConfig config;
+    config.t_rcd = 10;
+    config.t_cas = 20;
+    config.t_rp = 30;
+    config.t_controller = 5;
+    DramModel dram(config);
+    uint32_t row_stride = config.row_size * config.banks; // same bank, next row
+
+    REQUIRE(dram.access(0x1000, false) == 5 + 10 + 20); // bank precharged
+    REQUIRE(dram.access(0x1040, false) == 5 + 20); // same row open
+    REQUIRE(dram.access(0x1000 + row_stride, true) == 5 + 30 + 10 + 20); // row conflict
+
+    const DramStats& stats = dram.getStats();
+    REQUIRE(stats.reads == 2);
+    REQUIRE(stats.writes == 1);
+    REQUIRE(stats.row_empty == 1);
+    REQUIRE(stats.row_hits == 1);
+    REQUIRE(stats.row_conflicts == 1);
+    REQUIRE(stats.total_cycles == 35 + 25 + 65);
+}
+
+TEST_CASE("DRAM - Closed Page Never Hits Or Conflicts", "[dram]") {
+    DramConfig config;
+    config.row_policy = "CLOSED";
+    DramModel dram(config);
+
+    uint64_t first = dram.access(0x1000, false);
+    REQUIRE(dram.access(0x1040, false) == first);
+    REQUIRE(dram.access(0x1000 + config.row_size * config.banks, false) == first);
+    REQUIRE(dram.getStats().row_hits == 0);
+    REQUIRE(dram.getStats().row_conflicts == 0);
+    REQUIRE(dram.getStats().row_empty == 3);
+}
+
+TEST_CASE("DRAM - Invalid Configuration Should Fail", "[dram]") {
+    DramConfig config;
+    SECTION("Zero banks") { config.banks = 0; }
+    SECTION("Row smaller than a block") { config.row_size = 32; }
+    SECTION("Unknown row policy") { config.row_policy = "ADAPTIVE"; }
+    REQUIRE_THROWS_AS(DramModel(config), CacheException);
+}
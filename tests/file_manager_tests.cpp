@@ -144,4 +144,28 @@ TEST_CASE("File Manager - getNextRequest Test ", "[io]") {
 
     std::optional<MemoryRequest> requestOpThree = fm.getNextRequest();
     REQUIRE_FALSE(requestOpThree.has_value()); // it is returning std::nullopt
-}
\ No newline at end of file
+}
+TEST_CASE("File Manager - 64-bit Addresses", "[io]") {
+    FileManager fm("valid_file_64bit.txt", false, true);
+    REQUIRE(fm.isValidFile());
+    REQUIRE_NOTHROW(fm.parseFile());
+    REQUIRE(fm.getNumOperations() == 2);
+    REQUIRE(fm.getNextRequest()->address == 0x7ffff7a01040ULL);
+    REQUIRE(fm.getNextRequest()->address == 0x7ffff7a01040ULL);
+
+    FileManager too_wide("invalid_read_address_64bit.txt", false, true);
+    REQUIRE(too_wide.isValidFile());
+    REQUIRE_THROWS_AS(too_wide.parseFile(), CacheException);
+}
+
+TEST_CASE("File Manager - Skip Requests", "[io][checkpoint]") {
+    FileManager fm("valid_file.txt", false, true);
+    fm.parseFile();
+
+    fm.skipRequests(5);
+    REQUIRE(fm.getNumOperations() == 15);
+    REQUIRE_THROWS_AS(fm.skipRequests(16), CacheException);
+    REQUIRE(fm.getNumOperations() == 15);
+    fm.skipRequests(15);
+    REQUIRE(fm.getNumOperations() == 0);
+}
@@ -0,0 +1,130 @@
+#include "../catch2/catch.hpp"
+#include "../src/io/interval_log.h"
+#include "../src/threading/core_hierarchy.h"
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+static std::string intervalLogPath() {
+    return (std::filesystem::temp_directory_path() / "interval_log_test.csv").string();
+}
+
+// data rows of the log, each split into its numeric columns
+static std::vector<std::vector<double>> readIntervalRows(const std::string& t_path) {
+    std::ifstream in(t_path);
+    std::string line;
+    std::getline(in, line); // header
+    std::vector<std::vector<double>> rows;
+    while (std::getline(in, line)) {
+        std::vector<double> row;
+        std::stringstream fields(line);
+        std::string field;
+        while (std::getline(fields, field, ',')) {
+            row.push_back(std::stod(field));
+        }
+        rows.push_back(row);
+    }
+    return rows;
+}
+
+static ValidParams intervalParams() {
+    ValidParams params;
+    params.l1_cache_size = 8 * 1024;
+    params.l2_cache_size = 64 * 1024;
+    params.l3_cache_size = 256 * 1024;
+    params.memory_size = "small";
+    params.num_threads = 1;
+    params.access_file_name = "valid_file.txt";
+    params.isVerbose = false;
+    params.l1_associativity = params.l2_associativity = params.l3_associativity = params.associativity = 4;
+    params.l1_replacement_policy = params.l2_replacement_policy = params.l3_replacement_policy = params.replacement_policy = "LRU";
+    params.l1_write_policy = params.l2_write_policy = params.l3_write_policy = params.write_policy = "WB";
+    return params;
+}
+
+static void runIntervalTrace(CoreHierarchy& t_hierarchy, uint64_t t_requests) {
+    for (uint64_t i = 0; i < t_requests; i++) {
+        uint64_t address = 0x1000 + ((i * 4164) % (1024 * 1024)) / 4 * 4;
+        t_hierarchy.access(MemoryRequest(i % 3 == 0 ? AccessType::WRITE : AccessType::READ, address, static_cast<int>(i)));
+    }
+    t_hierarchy.finish();
+}
+
+TEST_CASE("Interval Log - Row Holds The Difference Between Snapshots", "[intervals]") {
+    IntervalSnapshot start, end;
+    start.requests = 100;
+    start.cycles = 1000;
+    start.l1_hits = 40;
+    start.l1_misses = 10;
+    end.requests = 200;
+    end.cycles = 2500;
+    end.l1_hits = 115;
+    end.l1_misses = 35;
+    end.dirty_evictions = 4;
+    end.coherence_invalidations = 2;
+
+    std::ostringstream out;
+    IntervalLog::writeRow(out, 3, start, end);
+    REQUIRE(out.str() == "3,100,199,1000,2500,100,1500,75,0,0,25,0,0,0,4,0,2,0,0\n");
+}
+
+TEST_CASE("Interval Log - Needs Exactly One Interval Kind", "[intervals]") {
+    REQUIRE_THROWS_AS(IntervalLog(intervalLogPath(), 0, 0), CacheException);
+    REQUIRE_THROWS_AS(IntervalLog(intervalLogPath(), 10, 10), CacheException);
+    REQUIRE_THROWS_AS(IntervalLog("/nonexistent_dir/log.csv", 10, 0), CacheException);
+}
+
+TEST_CASE("Interval Log - Request Intervals Cover The Run", "[intervals]") {
+    ValidParams params = intervalParams();
+    params.warmup_requests = 500;
+    Memory memory(4 * 1024 * 1024, false);
+    CacheStats stats;
+    {
+        IntervalLog log(intervalLogPath(), 3000, 0);
+        CoreHierarchy hierarchy(params, memory, &stats);
+        hierarchy.attachIntervalLog(&log);
+        runIntervalTrace(hierarchy, 10000);
+    }
+
+    std::vector<std::vector<double>> rows = readIntervalRows(intervalLogPath());
+    std::filesystem::remove(intervalLogPath());
+    // the warm-up closes its own interval, the rest are counted from its end
+    REQUIRE(rows.size() == 5);
+    std::vector<double> sizes = {500, 3000, 3000, 3000, 500};
+    double misses = 0, next_request = 0;
+    for (size_t i = 0; i < rows.size(); i++) {
+        REQUIRE(rows[i][0] == i);
+        REQUIRE(rows[i][1] == next_request);
+        REQUIRE(rows[i][5] == sizes[i]);
+        next_request = rows[i][2] + 1;
+        if (i > 0) misses += rows[i][10];
+    }
+    REQUIRE(next_request == 10000);
+    REQUIRE(misses == stats.l1_misses); // the intervals after the warm-up add up to the summary
+}
+
+TEST_CASE("Interval Log - Cycle Intervals", "[intervals]") {
+    ValidParams params = intervalParams();
+    Memory memory(4 * 1024 * 1024, false);
+    CacheStats stats;
+    {
+        IntervalLog log(intervalLogPath(), 0, 100000);
+        CoreHierarchy hierarchy(params, memory, &stats);
+        hierarchy.attachIntervalLog(&log);
+        runIntervalTrace(hierarchy, 5000);
+    }
+
+    std::vector<std::vector<double>> rows = readIntervalRows(intervalLogPath());
+    std::filesystem::remove(intervalLogPath());
+    REQUIRE(rows.size() > 2);
+    double requests = 0;
+    for (size_t i = 0; i < rows.size(); i++) {
+        if (i + 1 < rows.size()) {
+            REQUIRE(rows[i][4] >= 100000 * (i + 1)); // closed by the first request to cross the boundary
+            REQUIRE(rows[i + 1][3] == rows[i][4]);
+        }
+        requests += rows[i][5];
+    }
+    REQUIRE(requests == 5000);
+    REQUIRE(rows.back()[4] == stats.total_cycles);
+}
@@ -1,6 +1,7 @@
 #include "../catch2/catch.hpp"
 #include "../src/memory/memory.h"
 #include "../src/exception/cache_exception.h"
+#include <sstream>
 
 const int memory_size = 4 * 1024 * 1024;
 
@@ -125,4 +126,62 @@ TEST_CASE("Profiling - Random Memory Access", "[memory][profiling]") {
     }
 
     REQUIRE(true);
-}
\ No newline at end of file
+}
+TEST_CASE("Memory - DRAM Timing Is Optional", "[memory][dram]") {
+    Memory memory(memory_size, false);
+    REQUIRE_FALSE(memory.hasDram());
+    REQUIRE_THROWS_AS(memory.accessDram(0x1000, false), CacheException);
+
+    memory.attachDram(DramConfig());
+    REQUIRE(memory.hasDram());
+    REQUIRE(memory.accessDram(0x1000, false) > 0);
+    REQUIRE(memory.getDram()->getStats().reads == 1);
+
+    // functional contents are unaffected by the timing model
+    memory.write(0x1000, 5);
+    REQUIRE(memory.read(0x1000) == 5);
+}
+
+TEST_CASE("Memory - Full Address Space", "[memory]") {
+    Memory bounded(memory_size, false);
+    REQUIRE_THROWS_AS(bounded.write(0x00007ffff7a00000ULL, 1), CacheException);
+
+    Memory memory(memory_size, false, true);
+    memory.write(0x00007ffff7a00000ULL, 1);
+    memory.write(0xfffffffffffffff0ULL, 2);
+    memory.write(0x0, 3);
+    REQUIRE(memory.read(0x00007ffff7a00000ULL) == 1);
+    REQUIRE(memory.read(0xfffffffffffffff0ULL) == 2);
+    REQUIRE(memory.read(0x0) == 3);
+    REQUIRE(memory.read(0x00007ffff7a00004ULL) == 0);
+    REQUIRE_THROWS_AS(memory.read(0x00007ffff7a00002ULL), CacheException);
+}
+
+TEST_CASE("Memory Checkpoint Round Trip", "[memory][checkpoint]") {
+    Memory memory(memory_size, false);
+    memory.write(0x1000, 7);
+    memory.write(0x2004, -3);
+    memory.write(0x3008, 0);
+    std::stringstream state;
+    memory.saveState(state);
+
+    Memory restored(memory_size, false);
+    restored.write(0x4000, 99); // overwritten by the restore
+    restored.restoreState(state);
+    REQUIRE(restored.read(0x1000) == 7);
+    REQUIRE(restored.read(0x2004) == -3);
+    REQUIRE(restored.read(0x3008) == 0);
+    REQUIRE(restored.read(0x4000) == 0);
+}
+
+TEST_CASE("Memory Checkpoint Outside The Configured Range", "[memory][checkpoint]") {
+    Memory wide(memory_size, false, true);
+    wide.write(0x7fff00001000ULL, 1);
+    std::stringstream state;
+    wide.saveState(state);
+
+    Memory memory(memory_size, false);
+    REQUIRE_THROWS_AS(memory.restoreState(state), CacheException);
+    std::stringstream truncated("abc");
+    REQUIRE_THROWS_AS(memory.restoreState(truncated), CacheException);
+}
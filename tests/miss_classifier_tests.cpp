@@ -0,0 +1,143 @@
+#include "../catch2/catch.hpp"
+#include "../src/cache/miss_classifier.h"
+#include "../src/cache/cache.h"
+#include "../src/threading/core_manager.h"
+
+static const int classifierMemorySize = 4 * 1024 * 1024;
+
+TEST_CASE("Miss Classifier - Rejects An Empty Shadow", "[classification]") {
+    REQUIRE_THROWS_AS(MissClassifier(0), CacheException);
+}
+
+TEST_CASE("Miss Classifier - Three Cs", "[classification]") {
+    MissClassifier classifier(2);
+    REQUIRE(classifier.access(1, false) == MissClass::COMPULSORY);
+    REQUIRE(classifier.access(2, false) == MissClass::COMPULSORY);
+    // both blocks fit a fully associative cache of two lines, so losing one is the mapping's fault
+    REQUIRE(classifier.access(1, false) == MissClass::CONFLICT);
+    REQUIRE(classifier.access(1, true) == MissClass::HIT);
+    // 3 pushes out 2, the least recently used block of the shadow
+    REQUIRE(classifier.access(3, false) == MissClass::COMPULSORY);
+    REQUIRE(classifier.access(2, false) == MissClass::CAPACITY);
+    REQUIRE(classifier.access(3, false) == MissClass::CONFLICT);
+}
+
+TEST_CASE("Miss Classifier - Coherence Misses", "[classification]") {
+    MissClassifier classifier(4);
+    classifier.access(7, false);
+    classifier.noteInvalidation(7);
+    REQUIRE(classifier.access(7, false) == MissClass::COHERENCE);
+    REQUIRE(classifier.access(7, false) == MissClass::CONFLICT); // the invalidation is consumed by the refetch
+}
+
+TEST_CASE("Miss Classifier - Direct-Mapped Conflicts And Capacity Sweep", "[classification][cache]") {
+    Memory memory(classifierMemorySize, false);
+    CacheStats stats;
+    Cache L1(1024, 1, "LRU", "WB", Level::L1, nullptr, memory, &stats); // 16 lines of 64 bytes
+    L1.enableMissClassification();
+    REQUIRE(L1.getMissClassifier()->getNumLines() == 16);
+
+    SECTION("two blocks sharing a set") {
+        for (int i = 0; i < 10; i++) {
+            L1.read((i % 2 == 0) ? 0x1000 : 0x1400);
+        }
+        REQUIRE(stats.l1_miss_classes.compulsory == 2);
+        REQUIRE(stats.l1_miss_classes.conflict == 8);
+        REQUIRE(stats.l1_miss_classes.capacity == 0);
+    }
+
+    SECTION("a working set twice the cache") {
+        for (int pass = 0; pass < 3; pass++) {
+            for (uint64_t block = 0; block < 32; block++) {
+                L1.write(0x1000 + block * 64, pass);
+            }
+        }
+        REQUIRE(stats.l1_miss_classes.compulsory == 32);
+        REQUIRE(stats.l1_miss_classes.capacity == 64);
+        REQUIRE(stats.l1_miss_classes.conflict == 0);
+    }
+
+    REQUIRE(stats.l1_miss_classes.total() == static_cast<uint64_t>(stats.l1_misses));
+}
+
+TEST_CASE("Miss Classifier - Every Level Accounts For All Misses", "[classification][cache]") {
+    Memory memory(classifierMemorySize, false);
+    CacheStats stats;
+    Cache L2(8 * 1024, 2, "FIFO", "WB", Level::L2, nullptr, memory, &stats);
+    Cache L1(1024, 2, "LRU", "WB", Level::L1, &L2, memory, &stats);
+    L1.enableMissClassification();
+    L2.enableMissClassification();
+
+    for (uint64_t i = 0; i < 5000; i++) {
+        uint64_t address = 0x1000 + ((i * 4164) % (64 * 1024)) / 4 * 4;
+        if (i % 3 == 0) {
+            L1.write(address, static_cast<int>(i));
+        } else {
+            L1.read(address);
+        }
+    }
+    REQUIRE(stats.l1_miss_classes.total() == static_cast<uint64_t>(stats.l1_misses));
+    REQUIRE(stats.l2_miss_classes.total() == static_cast<uint64_t>(stats.l2_misses));
+    REQUIRE(stats.l1_miss_classes.capacity > 0);
+    REQUIRE(stats.l2_miss_classes.coherence == 0);
+}
+
+TEST_CASE("Miss Classifier - Coherence Invalidation Drops The Line", "[classification][cache]") {
+    Memory memory(classifierMemorySize, false);
+    CacheStats stats;
+    Cache L1(1024, 2, "LRU", "WB", Level::L1, nullptr, memory, &stats);
+    L1.enableMissClassification();
+
+    L1.write(0x1100, 42);
+    REQUIRE(memory.read(0x1100) == 0);
+    L1.invalidateForCoherence(0x1100);
+    REQUIRE(memory.read(0x1100) == 42); // the dirty copy is written back before it is dropped
+    REQUIRE(L1.findCacheLine(0x1100) == nullptr);
+
+    REQUIRE(L1.read(0x1100) == 42);
+    REQUIRE(stats.l1_misses == 2);
+    REQUIRE(stats.l1_miss_classes.compulsory == 1);
+    REQUIRE(stats.l1_miss_classes.coherence == 1);
+}
+
+TEST_CASE("Miss Classifier - Another Core's Write Causes A Coherence Miss", "[classification][core_manager]") {
+    ValidParams params;
+    params.l1_cache_size = 16 * 1024;
+    params.l2_cache_size = 64 * 1024;
+    params.l3_cache_size = 512 * 1024;
+    params.memory_size = "small";
+    params.num_threads = 2;
+    params.access_file_name = "valid_file.txt";
+    params.isVerbose = false;
+    params.l1_associativity = params.l2_associativity = params.l3_associativity = params.associativity = 4;
+    params.l1_replacement_policy = params.l2_replacement_policy = params.l3_replacement_policy = params.replacement_policy = "LRU";
+    params.l1_write_policy = params.l2_write_policy = params.l3_write_policy = params.write_policy = "WB";
+    params.classify_misses = true;
+
+    Memory memory(classifierMemorySize, false);
+    FileManager fm(params.access_file_name, params.isVerbose, true);
+    CacheStats stats;
+    CoreManager coreManager(params.num_threads, &params, &fm, memory, params.isVerbose, &stats);
+    Cache* core0 = coreManager.getL1Cache(0);
+    Cache* core1 = coreManager.getL1Cache(1);
+
+    auto [holder_writes, expected_writebacks] = GENERATE(
+        std::make_tuple(true, 1),  // core 0 holds the block MODIFIED
+        std::make_tuple(false, 0)  // core 0 holds the block EXCLUSIVE after its read miss
+    );
+    if (holder_writes) {
+        core0->write(0x2000, 7);
+        REQUIRE(core0->findCacheLine(0x2000)->m_mesi_state == MESI_State::MODIFIED);
+    } else {
+        core0->read(0x2000);
+        REQUIRE(core0->findCacheLine(0x2000)->m_mesi_state == MESI_State::EXCLUSIVE);
+    }
+    core1->read(0x2000); // core 1 holds a copy too, so its write takes the hit path
+    core1->write(0x2000, 9);
+
+    REQUIRE(core0->findCacheLine(0x2000) == nullptr);
+    REQUIRE(stats.coherence_writebacks == static_cast<uint64_t>(expected_writebacks));
+    REQUIRE(stats.l1_miss_classes.coherence == 0);
+    core0->read(0x2000);
+    REQUIRE(stats.l1_miss_classes.coherence == 1);
+}
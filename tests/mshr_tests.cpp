@@ -0,0 +1,43 @@
+#include "../catch2/catch.hpp"
+#include "../src/cache/mshr.h"
+#include "../src/exception/cache_exception.h"
+
+TEST_CASE("MSHR - Entries Retire When Their Fill Completes", "[mshr]") {
+    MshrFile mshrs(2);
+    REQUIRE(mshrs.reserve(0x1000, 0) == 0);
+    mshrs.allocate(0x1000, 100);
+    REQUIRE(mshrs.reserve(0x2000, 10) == 0);
+    mshrs.allocate(0x2000, 150);
+    REQUIRE(mshrs.getOccupancy() == 2);
+
+    uint64_t ready = 0;
+    REQUIRE(mshrs.isPending(0x1000, ready));
+    REQUIRE(ready == 100);
+    REQUIRE_FALSE(mshrs.isPending(0x3000, ready));
+
+    mshrs.retire(100);
+    REQUIRE(mshrs.getOccupancy() == 1);
+    REQUIRE_FALSE(mshrs.isPending(0x1000, ready));
+    REQUIRE(mshrs.getLastCompletion() == 150);
+}
+
+TEST_CASE("MSHR - Full File Waits For The Earliest Fill", "[mshr]") {
+    MshrFile mshrs(2);
+    mshrs.reserve(0x1000, 0);
+    mshrs.allocate(0x1000, 300);
+    mshrs.reserve(0x2000, 0);
+    mshrs.allocate(0x2000, 120);
+
+    REQUIRE(mshrs.reserve(0x3000, 20) == 100); // waits for 0x2000
+    mshrs.allocate(0x3000, 400);
+    uint64_t ready = 0;
+    REQUIRE_FALSE(mshrs.isPending(0x2000, ready));
+    REQUIRE(mshrs.isPending(0x1000, ready));
+
+    // a block that already owns an entry reuses it
+    REQUIRE(mshrs.reserve(0x1000, 20) == 0);
+}
+
+TEST_CASE("MSHR - Invalid Size Should Fail", "[mshr]") {
+    REQUIRE_THROWS_AS(MshrFile(0), CacheException);
+}
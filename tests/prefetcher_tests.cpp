@@ -0,0 +1,91 @@
+#include "../catch2/catch.hpp"
+#include "../src/cache/prefetcher.h"
+#include "../src/exception/cache_exception.h"
+
+TEST_CASE("Prefetcher - Factory", "[prefetcher]") {
+    auto [type, expectedName] = GENERATE(
+        std::make_tuple("NEXT_LINE", "NEXT_LINE"),
+        std::make_tuple("STRIDE", "STRIDE"),
+        std::make_tuple("STREAM", "STREAM")
+    );
+
+    std::unique_ptr<Prefetcher> prefetcher = createPrefetcher(type, 2);
+    REQUIRE(prefetcher != nullptr);
+    REQUIRE(prefetcher->getName() == expectedName);
+    REQUIRE(prefetcher->getDegree() == 2);
+
+    REQUIRE(createPrefetcher("NONE", 1) == nullptr);
+    REQUIRE_THROWS_AS(createPrefetcher("MARKOV", 1), CacheException);
+    REQUIRE_THROWS_AS(createPrefetcher("NEXT_LINE", 0), CacheException);
+}
+
+TEST_CASE("Prefetcher - Next-N-Line", "[prefetcher]") {
+    NextLinePrefetcher prefetcher(3);
+    std::vector<uint64_t> candidates;
+
+    prefetcher.train(0x1000, candidates);
+    REQUIRE(candidates == std::vector<uint64_t>{0x1040, 0x1080, 0x10C0});
+
+    NextLinePrefetcher wide_prefetcher(2, 128);
+    candidates.clear();
+    wide_prefetcher.train(0x1000, candidates);
+    REQUIRE(candidates == std::vector<uint64_t>{0x1080, 0x1100});
+}
+
+TEST_CASE("Prefetcher - Stride Needs Repeated Delta", "[prefetcher]") {
+    StridePrefetcher prefetcher(2);
+    std::vector<uint64_t> candidates;
+
+    prefetcher.train(0x1000, candidates);
+    prefetcher.train(0x1100, candidates);
+    REQUIRE(candidates.empty()); // delta seen once
+
+    prefetcher.train(0x1200, candidates);
+    REQUIRE(candidates == std::vector<uint64_t>{0x1300, 0x1400});
+
+    candidates.clear();
+    prefetcher.train(0x1240, candidates); // off the stride, starts a new entry
+    REQUIRE(candidates.empty());
+
+    prefetcher.train(0x1300, candidates); // the trained stream is still there
+    REQUIRE(candidates == std::vector<uint64_t>{0x1400, 0x1500});
+}
+
+TEST_CASE("Prefetcher - Stride Tracks Interleaved Streams Independently", "[prefetcher]") {
+    StridePrefetcher prefetcher(1);
+    std::vector<uint64_t> candidates;
+
+    // two interleaved streams further apart than their strides
+    for (uint64_t i = 0; i < 3; i++) {
+        prefetcher.train(0x10000 + i * 0x80, candidates);
+        prefetcher.train(0x20F00 - i * 0x40, candidates);
+    }
+    REQUIRE(candidates == std::vector<uint64_t>{0x10180, 0x20E40});
+}
+
+TEST_CASE("Prefetcher - Stride Learns Strides Beyond A Page", "[prefetcher]") {
+    StridePrefetcher prefetcher(2);
+    std::vector<uint64_t> candidates;
+
+    // an 8KB column walk interleaved with a descending 1MB one
+    for (uint64_t i = 0; i < 3; i++) {
+        prefetcher.train(0x100000 + i * 0x2000, candidates);
+        prefetcher.train(0x40000000 - i * 0x100000, candidates);
+    }
+    REQUIRE(candidates == std::vector<uint64_t>{0x106000, 0x108000, 0x3FD00000, 0x3FC00000});
+}
+
+TEST_CASE("Prefetcher - Stream Runs Ahead Once Direction Is Confirmed", "[prefetcher]") {
+    StreamPrefetcher prefetcher(4);
+    std::vector<uint64_t> candidates;
+
+    prefetcher.train(0x2000, candidates);
+    REQUIRE(candidates.empty());
+
+    prefetcher.train(0x1FC0, candidates); // descending stream
+    REQUIRE(candidates == std::vector<uint64_t>{0x1F80, 0x1F40, 0x1F00, 0x1EC0});
+
+    candidates.clear();
+    prefetcher.train(0x1F80, candidates); // only tops the window back up
+    REQUIRE(candidates == std::vector<uint64_t>{0x1E80});
+}
@@ -0,0 +1,76 @@
+#include "../catch2/catch.hpp"
+#include "../src/cache/reuse_profiler.h"
+#include <random>
+#include <set>
+
+TEST_CASE("Reuse Profiler - Log2 Buckets", "[reuse]") {
+    REQUIRE(ReuseProfiler::bucketOf(0) == 0);
+    REQUIRE(ReuseProfiler::bucketOf(1) == 1);
+    REQUIRE(ReuseProfiler::bucketOf(2) == 2);
+    REQUIRE(ReuseProfiler::bucketOf(3) == 2);
+    REQUIRE(ReuseProfiler::bucketOf(4) == 3);
+    REQUIRE(ReuseProfiler::bucketOf(1023) == 10);
+    REQUIRE(ReuseProfiler::bucketOf(1024) == 11);
+    REQUIRE(ReuseProfiler::bucketOf(UINT64_MAX) == ReuseProfiler::BUCKETS - 1);
+}
+
+TEST_CASE("Reuse Profiler - Reuse And Stack Distance Of A Short Stream", "[reuse]") {
+    ReuseProfiler profiler(64);
+    // blocks A B B C A: the second B reuses after 0 accesses, A after 3 accesses and 2 unique blocks
+    for (uint64_t address : {0x1000, 0x1040, 0x1044, 0x1080, 0x1010}) {
+        profiler.record(address);
+    }
+    REQUIRE(profiler.getAccesses() == 5);
+    REQUIRE(profiler.getColdAccesses() == 3);
+    REQUIRE(profiler.getDistinctBlocks() == 3);
+    REQUIRE(profiler.getReuseHistogram()[0] == 1);
+    REQUIRE(profiler.getStackHistogram()[0] == 1);
+    REQUIRE(profiler.getReuseHistogram()[ReuseProfiler::bucketOf(3)] == 1);
+    REQUIRE(profiler.getStackHistogram()[ReuseProfiler::bucketOf(2)] == 1);
+
+    // counts start over but the recency state stays, so B is not cold and C, A were touched since
+    profiler.resetCounts();
+    profiler.record(0x1040);
+    REQUIRE(profiler.getAccesses() == 1);
+    REQUIRE(profiler.getColdAccesses() == 0);
+    REQUIRE(profiler.getStackHistogram()[ReuseProfiler::bucketOf(2)] == 1);
+}
+
+TEST_CASE("Reuse Profiler - Matches A Naive Scan Across Slot Compactions", "[reuse]") {
+    std::mt19937_64 rng(7);
+    std::vector<uint64_t> blocks;
+    for (int i = 0; i < 6000; i++) {
+        // mostly a small hot set, with a tail of colder blocks
+        uint64_t block = (rng() % 4 == 0) ? rng() % 3000 : rng() % 40;
+        blocks.push_back(block);
+    }
+
+    ReuseProfiler profiler(64);
+    std::vector<uint64_t> reuse(ReuseProfiler::BUCKETS, 0);
+    std::vector<uint64_t> stack(ReuseProfiler::BUCKETS, 0);
+    uint64_t cold = 0;
+    for (size_t i = 0; i < blocks.size(); i++) {
+        profiler.record(blocks[i] * 64);
+        std::set<uint64_t> seen;
+        bool found = false;
+        for (size_t j = i; j-- > 0;) {
+            if (blocks[j] == blocks[i]) {
+                reuse[ReuseProfiler::bucketOf(i - j - 1)]++;
+                stack[ReuseProfiler::bucketOf(seen.size())]++;
+                found = true;
+                break;
+            }
+            seen.insert(blocks[j]);
+        }
+        if (!found) cold++;
+    }
+
+    REQUIRE(profiler.getColdAccesses() == cold);
+    REQUIRE(profiler.getReuseHistogram() == reuse);
+    REQUIRE(profiler.getStackHistogram() == stack);
+}
+
+TEST_CASE("Reuse Profiler - Invalid Block Size", "[reuse]") {
+    REQUIRE_THROWS_AS(ReuseProfiler(48), CacheException);
+    REQUIRE_THROWS_AS(ReuseProfiler(0), CacheException);
+}
@@ -0,0 +1,157 @@
+#include "../catch2/catch.hpp"
+#include "../src/threading/self_profile.h"
+#include "../src/threading/core_manager.h"
+#include <thread>
+
+TEST_CASE("Self Profile - Phases Add Up By Name", "[self_profile]") {
+    SelfProfile profile;
+    profile.addPhase("parse", std::chrono::milliseconds(10));
+    profile.addPhase("simulation", std::chrono::milliseconds(200));
+    profile.addPhase("simulation", std::chrono::milliseconds(300));
+    profile.setRequests(1000);
+
+    REQUIRE(profile.getPhases().size() == 2);
+    REQUIRE(profile.getPhases()[0].first == "parse");
+    REQUIRE(profile.phaseSeconds("simulation") == Approx(0.5));
+    REQUIRE(profile.phaseSeconds("flush") == 0.0);
+    REQUIRE(profile.requestsPerSecond() == Approx(2000.0));
+}
+
+TEST_CASE("Self Profile - Scoped Phase", "[self_profile]") {
+    SelfProfile profile;
+    {
+        ScopedPhase phase(&profile, "flush");
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    { ScopedPhase phase(nullptr, "flush"); } // no profile, nothing recorded
+
+    REQUIRE(profile.getPhases().size() == 1);
+    REQUIRE(profile.phaseSeconds("flush") >= 0.005);
+    REQUIRE(profile.requestsPerSecond() == 0.0);
+}
+
+TEST_CASE("Self Profile - Profiled Mutex Counts Contention", "[self_profile]") {
+    ProfiledMutex mutex;
+    ThreadProfile waiter;
+    mutex.lock(); // this thread has no profile, a plain lock
+    std::thread thread([&]() {
+        ProfiledMutex::setThreadProfile(&waiter);
+        waiter.in_access = true;
+        mutex.lock();
+        mutex.unlock();
+        waiter.in_access = false;
+        mutex.lock(); // uncontended now
+        mutex.unlock();
+        ProfiledMutex::setThreadProfile(nullptr);
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    mutex.unlock();
+    thread.join();
+
+    REQUIRE(waiter.lock_acquisitions == 2);
+    REQUIRE(waiter.contended_acquisitions == 1);
+    REQUIRE(waiter.lock_wait >= std::chrono::milliseconds(10));
+    REQUIRE(waiter.access_lock_wait == waiter.lock_wait);
+}
+
+TEST_CASE("Self Profile - Thread Time Splits Into Simulating, Lock Wait And Idle", "[self_profile]") {
+    ThreadProfile profile;
+    profile.lifetime = std::chrono::milliseconds(100);
+    profile.busy = std::chrono::milliseconds(60);
+    profile.lock_wait = std::chrono::milliseconds(30);
+    profile.access_lock_wait = std::chrono::milliseconds(10);
+
+    REQUIRE(profile.simulating() == std::chrono::milliseconds(50));
+    REQUIRE(profile.idle() == std::chrono::milliseconds(20));
+    REQUIRE(profile.simulating() + profile.lock_wait + profile.idle() == profile.lifetime);
+}
+
+TEST_CASE("Self Profile - Core Manager Records Every Worker", "[self_profile][core_manager]") {
+    ValidParams params;
+    params.l1_cache_size = 16 * 1024;
+    params.l2_cache_size = 64 * 1024;
+    params.l3_cache_size = 512 * 1024;
+    params.memory_size = "medium";
+    params.num_threads = 2;
+    params.replacement_policy = "LRU";
+    params.write_policy = "WB";
+    params.access_file_name = "valid_file.txt";
+    params.isVerbose = false;
+    params.associativity = 4;
+    params.l1_associativity = params.l2_associativity = params.l3_associativity = params.associativity;
+    params.l1_replacement_policy = params.l2_replacement_policy = params.l3_replacement_policy = params.replacement_policy;
+    params.l1_write_policy = params.l2_write_policy = params.l3_write_policy = params.write_policy;
+
+    Memory memory(16 * 1024 * 1024, params.isVerbose);
+    FileManager fm(params.access_file_name, params.isVerbose, true);
+    fm.parseFile();
+    CacheStats stats;
+    SelfProfile profile;
+    CoreManager coreManager(params.num_threads, &params, &fm, memory, params.isVerbose, &stats);
+    coreManager.attachSelfProfile(&profile);
+    coreManager.startSimulation();
+
+    REQUIRE(profile.getThreads().size() == 2);
+    uint64_t requests = 0;
+    for (const ThreadProfile& thread : profile.getThreads()) {
+        requests += thread.requests;
+        REQUIRE(thread.lock_acquisitions >= thread.requests); // one handout per request at least
+        REQUIRE(thread.busy <= thread.lifetime);
+    }
+    REQUIRE(requests == static_cast<uint64_t>(stats.total_operations));
+    REQUIRE(profile.phaseSeconds("simulation") > 0.0);
+    REQUIRE(profile.getPhases().size() == 2); // simulation and flush
+}
+
+TEST_CASE("Self Profile - Perf Sample Differences", "[self_profile][perf_counters]") {
+    PerfSample earlier, later;
+    earlier.counted[PerfSample::CYCLES] = later.counted[PerfSample::CYCLES] = true;
+    earlier.counted[PerfSample::INSTRUCTIONS] = later.counted[PerfSample::INSTRUCTIONS] = true;
+    later.counted[PerfSample::LLC_MISSES] = true; // only counted at one end
+    earlier.values[PerfSample::CYCLES] = 100;
+    later.values[PerfSample::CYCLES] = 1100;
+    earlier.values[PerfSample::INSTRUCTIONS] = 500;
+    later.values[PerfSample::INSTRUCTIONS] = 2500;
+
+    PerfSample difference = later - earlier;
+    REQUIRE(difference.values[PerfSample::CYCLES] == 1000);
+    REQUIRE(difference.values[PerfSample::INSTRUCTIONS] == 2000);
+    REQUIRE(difference.ipc() == Approx(2.0));
+    REQUIRE_FALSE(difference.counted[PerfSample::LLC_MISSES]);
+    REQUIRE((earlier - later).values[PerfSample::CYCLES] == 0); // a scaled count stepping back
+
+    difference += difference;
+    REQUIRE(difference.values[PerfSample::CYCLES] == 2000);
+    REQUIRE_FALSE(PerfSample().any());
+    REQUIRE(PerfSample().ipc() == 0.0);
+}
+
+TEST_CASE("Self Profile - Perf Counters Count Or Say Why Not", "[self_profile][perf_counters]") {
+    PerfCounters counters(false);
+    PerfSample start = counters.read();
+    volatile uint64_t sum = 0;
+    for (uint64_t i = 0; i < 1000000; i++) sum = sum + i;
+    PerfSample work = counters.read() - start;
+
+    if (counters.isAvailable()) {
+        REQUIRE(work.any());
+        if (work.counted[PerfSample::INSTRUCTIONS]) {
+            REQUIRE(work.values[PerfSample::INSTRUCTIONS] >= 1000000);
+        }
+    } else {
+        REQUIRE_FALSE(work.any()); // e.g. a VM without a PMU
+        REQUIRE_FALSE(counters.getError().empty());
+    }
+}
+
+TEST_CASE("Self Profile - Phases Carry Host Counters", "[self_profile][perf_counters]") {
+    SelfProfile profile;
+    { ScopedPhase phase(&profile, "parse"); }
+    REQUIRE_FALSE(profile.getPhaseCounters()[0].any()); // not enabled
+
+    profile.enablePerfCounters();
+    REQUIRE(profile.hasPerfCounters());
+    { ScopedPhase phase(&profile, "simulation"); }
+    REQUIRE(profile.getPhaseCounters().size() == 2);
+    REQUIRE(profile.getPhaseCounters()[1].any() == profile.readCounters().any());
+}
@@ -0,0 +1,121 @@
+#include "../catch2/catch.hpp"
+#include "../src/cache/heavy_hitters.h"
+#include "../src/cache/set_profiler.h"
+#include "../src/cache/cache.h"
+#include <random>
+#include <sstream>
+#include <unordered_map>
+
+static const int heatmapMemorySize = 4 * 1024 * 1024;
+
+TEST_CASE("Heavy Hitters - Exact While Every Key Has A Counter", "[heatmap]") {
+    HeavyHitters hitters(4);
+    for (uint64_t key : {7, 3, 7, 9, 7, 3}) {
+        hitters.add(key);
+    }
+    std::vector<HeavyHitters::Counter> top = hitters.top(2);
+    REQUIRE(top.size() == 2);
+    REQUIRE(top[0].m_key == 7);
+    REQUIRE(top[0].m_count == 3);
+    REQUIRE(top[0].m_error == 0);
+    REQUIRE(top[1].m_key == 3);
+    REQUIRE(top[1].m_count == 2);
+    REQUIRE(hitters.top(10).size() == 3);
+
+    hitters.clear();
+    REQUIRE(hitters.top(10).empty());
+    REQUIRE_THROWS_AS(HeavyHitters(0), CacheException);
+}
+
+TEST_CASE("Heavy Hitters - Space-Saving Bounds On A Skewed Stream", "[heatmap]") {
+    HeavyHitters hitters(16);
+    std::unordered_map<uint64_t, uint64_t> exact;
+    std::mt19937_64 rng(7);
+    const int stream = 20000;
+    for (int i = 0; i < stream; i++) {
+        // a few hot keys among many cold ones
+        uint64_t key = (i % 4 == 0) ? rng() % 3 : 100 + rng() % 5000;
+        hitters.add(key);
+        exact[key]++;
+    }
+    std::vector<HeavyHitters::Counter> top = hitters.top(16);
+    uint64_t total = 0;
+    for (const HeavyHitters::Counter& counter : top) {
+        total += counter.m_count;
+        REQUIRE(counter.m_count >= exact[counter.m_key]);
+        REQUIRE(counter.m_count - counter.m_error <= exact[counter.m_key]);
+    }
+    REQUIRE(total == stream); // the counters always sum to the stream length
+    for (int rank = 0; rank < 3; rank++) {
+        REQUIRE(top[rank].m_key < 3); // every key above stream / capacity is found and ranked first
+    }
+}
+
+TEST_CASE("Set Profiler - Per-Set Counters From The Cache", "[heatmap][cache]") {
+    Memory memory(heatmapMemorySize, false);
+    CacheStats stats;
+    Cache L1(1024, 1, "LRU", "WB", Level::L1, nullptr, memory, &stats); // 16 direct-mapped sets
+    L1.attachSetProfiler(2);
+    const SetProfiler* profiler = L1.getSetProfiler();
+    REQUIRE(profiler->getSets().size() == 16);
+
+    // set 0 thrashes between two blocks, set 1 hits after its first access
+    for (int i = 0; i < 10; i++) {
+        L1.read((i % 2 == 0) ? 0x1000 : 0x1400);
+        L1.read(0x1040);
+    }
+    const std::vector<SetProfiler::SetCounters>& sets = profiler->getSets();
+    REQUIRE(sets[0].m_accesses == 10);
+    REQUIRE(sets[0].m_misses == 10);
+    REQUIRE(sets[0].m_evictions == 9);
+    REQUIRE(sets[1].m_accesses == 10);
+    REQUIRE(sets[1].m_misses == 1);
+    REQUIRE(sets[1].m_evictions == 0);
+    REQUIRE(sets[2].m_accesses == 0);
+
+    std::vector<HeavyHitters::Counter> hot = profiler->getHotBlocks();
+    REQUIRE(hot[0].m_key == 0x1040);
+    REQUIRE(hot[0].m_count == 10);
+    std::vector<HeavyHitters::Counter> missed = profiler->getMissedBlocks();
+    REQUIRE(missed.size() == 2);
+    REQUIRE(missed[0].m_count == 5);
+    REQUIRE(missed[1].m_count == 5);
+
+    L1.resetSetProfile();
+    REQUIRE(profiler->getSets()[0].m_accesses == 0);
+    REQUIRE(profiler->getHotBlocks().empty());
+}
+
+TEST_CASE("Set Profiler - Heat Map Only Skips The Block Sketches", "[heatmap]") {
+    SetProfiler profiler(4, 0);
+    REQUIRE_FALSE(profiler.tracksBlocks());
+    profiler.recordAccess(2, 0x2080, false);
+    profiler.recordAccess(2, 0x2080, true);
+    profiler.resetCounts();
+    profiler.recordAccess(2, 0x2080, false);
+
+    REQUIRE(profiler.getSets()[2].m_accesses == 1);
+    REQUIRE(profiler.getSets()[2].m_misses == 1);
+    REQUIRE(profiler.getHotBlocks().empty());
+    REQUIRE(profiler.getMissedBlocks().empty());
+    REQUIRE(SetProfiler(4, 1).tracksBlocks());
+    REQUIRE_THROWS_AS(SetProfiler(4, -1), CacheException);
+}
+
+TEST_CASE("Set Profiler - CSV Rows", "[heatmap]") {
+    SetProfiler profiler(2, 1);
+    profiler.recordAccess(1, 0x2040, false);
+    profiler.recordAccess(1, 0x2040, true);
+    profiler.recordEviction(1);
+
+    std::ostringstream sets;
+    SetProfiler::writeSetHeader(sets);
+    profiler.writeSets(sets, "L1.0");
+    REQUIRE(sets.str() == "cache,set,accesses,misses,evictions,miss_rate\nL1.0,0,0,0,0,0\nL1.0,1,2,1,1,0.5\n");
+
+    std::ostringstream blocks;
+    SetProfiler::writeHotBlockHeader(blocks);
+    profiler.writeHotBlocks(blocks, "L2.1");
+    REQUIRE(blocks.str() == "cache,ranking,rank,block_address,count,max_overcount\n"
+                            "L2.1,accesses,1,0x2040,2,0\nL2.1,misses,1,0x2040,1,0\n");
+}
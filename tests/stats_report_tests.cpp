@@ -0,0 +1,75 @@
+#include "../catch2/catch.hpp"
+#include "../src/io/stats_report.h"
+#include <sstream>
+#include <limits>
+
+TEST_CASE("Stats Report - JSON Groups Fields By Section", "[report]") {
+    StatsReport report;
+    report.add("run", "trace", std::string("a \"quoted\"\\path"));
+    report.add("l1", "hits", 3);
+    report.add("run", "threads", 2);
+    report.add("l1", "hit_rate", 37.5);
+    report.add("config", "dram", false);
+    report.add("timing", "amat", std::numeric_limits<double>::quiet_NaN());
+
+    std::ostringstream out;
+    report.writeJson(out);
+    REQUIRE(out.str() ==
+        "{\n"
+        "  \"run\": {\n"
+        "    \"trace\": \"a \\\"quoted\\\"\\\\path\",\n"
+        "    \"threads\": 2\n"
+        "  },\n"
+        "  \"l1\": {\n"
+        "    \"hits\": 3,\n"
+        "    \"hit_rate\": 37.5\n"
+        "  },\n"
+        "  \"config\": {\n"
+        "    \"dram\": false\n"
+        "  },\n"
+        "  \"timing\": {\n"
+        "    \"amat\": null\n"
+        "  }\n"
+        "}\n");
+}
+
+TEST_CASE("Stats Report - One-Row CSV", "[report]") {
+    StatsReport report;
+    report.add("run", "trace", std::string("trace,with \"comma\".txt"));
+    report.add("l1", "misses", uint64_t{12});
+    report.add("l1", "hit_rate", 0.25);
+
+    std::ostringstream out;
+    report.writeCsv(out);
+    REQUIRE(out.str() == "run.trace,l1.misses,l1.hit_rate\n\"trace,with \"\"comma\"\".txt\",12,0.25\n");
+}
+
+TEST_CASE("Stats Report - Cache Statistics Sections", "[report]") {
+    CacheStats stats;
+    stats.total_operations = 10;
+    stats.l1_hits = 6;
+    stats.l1_misses = 4;
+    stats.core_cycles = {100, 200};
+
+    StatsReport plain;
+    plain.addCacheStats(stats);
+    std::ostringstream plain_csv;
+    plain.writeCsv(plain_csv);
+    std::string header = plain_csv.str().substr(0, plain_csv.str().find('\n'));
+    REQUIRE(header.find("l1.hit_rate") != std::string::npos);
+    REQUIRE(header.find("core_cycles.1") != std::string::npos);
+    REQUIRE(header.find("compulsory_misses") == std::string::npos);
+    REQUIRE(header.find("l3_set_sampling") == std::string::npos);
+    REQUIRE(header.find("time_sampling") == std::string::npos);
+
+    stats.classify_misses = true;
+    stats.l3_sample_ratio = 4;
+    StatsReport detailed;
+    detailed.addCacheStats(stats);
+    REQUIRE(detailed.size() == plain.size() + 3 * 4 + 8);
+
+    std::ostringstream json;
+    plain.writeJson(json);
+    REQUIRE(json.str().find("\"hit_rate\": 60") != std::string::npos);
+    REQUIRE(json.str().find("\"1\": 200") != std::string::npos);
+}
@@ -0,0 +1,163 @@
+#include "../catch2/catch.hpp"
+#include "../src/threading/sweep_runner.h"
+#include "../src/threading/core_hierarchy.h"
+#include <sstream>
+
+static ValidParams sweepParams() {
+    ValidParams params;
+    params.l1_cache_size = 8 * 1024;
+    params.l2_cache_size = 64 * 1024;
+    params.l3_cache_size = 256 * 1024;
+    params.memory_size = "small";
+    params.num_threads = 1;
+    params.replacement_policy = "LRU";
+    params.write_policy = "WB";
+    params.access_file_name = "valid_file.txt";
+    params.isVerbose = false;
+    params.associativity = 4;
+    params.l1_associativity = params.l2_associativity = params.l3_associativity = params.associativity;
+    params.l1_replacement_policy = params.l2_replacement_policy = params.l3_replacement_policy = params.replacement_policy;
+    params.l1_write_policy = params.l2_write_policy = params.l3_write_policy = params.write_policy;
+    return params;
+}
+
+static std::vector<MemoryRequest> sweepTrace() {
+    std::vector<MemoryRequest> requests;
+    for (uint64_t i = 0; i < 2000; i++) {
+        uint64_t address = 0x1000 + ((i * 4160) % (512 * 1024));
+        requests.emplace_back(i % 3 == 0 ? AccessType::WRITE : AccessType::READ, address, static_cast<int>(i));
+    }
+    return requests;
+}
+
+TEST_CASE("Sweep - Cartesian Product Of The Lists", "[sweep]") {
+    ValidParams params = sweepParams();
+    params.sweep_l1_sizes = {8 * 1024, 16 * 1024, 48 * 1024};
+    params.sweep_associativities = {1, 4};
+    params.sweep_policies = {"LRU", "PLRU"};
+    std::vector<MemoryRequest> requests;
+    SweepRunner runner(params, requests, 4 * 1024 * 1024);
+
+    std::vector<SweepPoint> points = runner.expandPoints();
+    REQUIRE(points.size() == 3 * 2 * 2);
+    REQUIRE(points.front().l2_cache_size == params.l2_cache_size); // lists not given keep the base value
+    REQUIRE(points.back().l1_cache_size == 48 * 1024);
+    REQUIRE(points.back().replacement_policy == "PLRU");
+
+    ValidParams applied = SweepRunner::applyPoint(params, points.back());
+    REQUIRE(applied.l3_associativity == 4);
+    REQUIRE(applied.l2_replacement_policy == "PLRU");
+}
+
+TEST_CASE("Sweep - Per-Level Settings Survive Dimensions Not Swept", "[sweep]") {
+    ValidParams params = sweepParams();
+    params.l3_associativity = 8;
+    params.l1_replacement_policy = "PLRU";
+    params.l2_write_policy = "WT";
+    params.sweep_l1_sizes = {8 * 1024, 16 * 1024};
+    std::vector<MemoryRequest> requests;
+    SweepRunner runner(params, requests, 4 * 1024 * 1024);
+
+    for (const SweepPoint& point : runner.expandPoints()) {
+        ValidParams applied = SweepRunner::applyPoint(params, point);
+        REQUIRE(applied.l1_associativity == 4);
+        REQUIRE(applied.l3_associativity == 8);
+        REQUIRE(applied.l1_replacement_policy == "PLRU");
+        REQUIRE(applied.l2_replacement_policy == "LRU");
+        REQUIRE(applied.l2_write_policy == "WT");
+
+        Memory memory(4 * 1024 * 1024, false);
+        CacheStats stats;
+        CoreHierarchy hierarchy(applied, memory, &stats);
+        REQUIRE(hierarchy.getL3()->getNumSets() == 256 * 1024 / 64 / 8);
+        REQUIRE(hierarchy.getL1()->getReplacementPolicy() == "PLRU");
+    }
+
+    params.sweep_associativities = {2}; // a swept dimension still sets every level
+    SweepRunner swept(params, requests, 4 * 1024 * 1024);
+    ValidParams applied = SweepRunner::applyPoint(params, swept.expandPoints().front());
+    REQUIRE(applied.l1_associativity == 2);
+    REQUIRE(applied.l3_associativity == 2);
+    REQUIRE(applied.l1_replacement_policy == "PLRU");
+}
+
+TEST_CASE("Sweep - Parallel Points Match Sequential Runs", "[sweep]") {
+    ValidParams params = sweepParams();
+    params.sweep_l1_sizes = {8 * 1024, 16 * 1024};
+    params.sweep_associativities = {1, 4, 8};
+    params.sweep_write_policies = {"WB", "WT"};
+    std::vector<MemoryRequest> requests = sweepTrace();
+    SweepRunner runner(params, requests, 4 * 1024 * 1024);
+
+    std::vector<SweepResult> results = runner.run(4);
+    REQUIRE(results.size() == 12);
+    for (const SweepResult& result : results) {
+        REQUIRE(result.error.empty());
+        Memory memory(4 * 1024 * 1024, false);
+        CacheStats expected;
+        CoreHierarchy hierarchy(SweepRunner::applyPoint(params, result.point), memory, &expected);
+        for (const MemoryRequest& request : requests) {
+            hierarchy.access(request);
+        }
+        hierarchy.finish();
+        REQUIRE(result.stats.l1_hits == expected.l1_hits);
+        REQUIRE(result.stats.l2_misses == expected.l2_misses);
+        REQUIRE(result.stats.memory_accesses == expected.memory_accesses);
+        REQUIRE(result.stats.core_cycles == expected.core_cycles);
+    }
+}
+
+TEST_CASE("Sweep - Invalid Geometry Is Reported Per Point", "[sweep]") {
+    ValidParams params = sweepParams();
+    params.sweep_associativities = {4, 12}; // 12 ways do not divide the 8KB L1
+    std::vector<MemoryRequest> requests = sweepTrace();
+    SweepRunner runner(params, requests, 4 * 1024 * 1024);
+
+    std::vector<SweepResult> results = runner.run(2);
+    REQUIRE(results[0].error.empty());
+    REQUIRE_FALSE(results[1].error.empty());
+
+    std::ostringstream out;
+    SweepRunner::writeResults(results, out);
+    std::string table = out.str();
+    REQUIRE(table.rfind("l1_size,l2_size,l3_size,assoc,policy,write_policy", 0) == 0);
+    REQUIRE(std::count(table.begin(), table.end(), '\n') == 3);
+    REQUIRE(table.find("not a multiple") != std::string::npos);
+}
+
+TEST_CASE("Sweep - Error Messages Are Quoted In The Table", "[sweep]") {
+    SweepResult result;
+    result.point = {8 * 1024, 64 * 1024, 256 * 1024, 4, "LRU", "WB"};
+    result.error = "bad \"geometry\", try again";
+
+    std::ostringstream out;
+    SweepRunner::writeResults({result}, out);
+    std::string row = out.str().substr(out.str().find('\n') + 1);
+    REQUIRE(row == "8192,65536,262144,4,LRU,WB,,,,,,,,\"bad \"\"geometry\"\", try again\"\n");
+}
+
+TEST_CASE("Sweep - Lockstep Batches Match Independent Runs", "[sweep]") {
+    auto [workers, batch] = GENERATE(
+        std::make_tuple(1, 64),
+        std::make_tuple(3, 500),
+        std::make_tuple(2, 100000) // one batch covers the whole trace
+    );
+    ValidParams params = sweepParams();
+    params.sweep_l1_sizes = {8 * 1024, 16 * 1024};
+    params.sweep_associativities = {1, 4, 12};
+    params.sweep_policies = {"LRU", "PLRU"};
+    std::vector<MemoryRequest> requests = sweepTrace();
+    SweepRunner runner(params, requests, 4 * 1024 * 1024);
+
+    std::vector<SweepResult> independent = runner.run(2);
+    std::vector<SweepResult> lockstep = runner.run(workers, batch);
+    REQUIRE(lockstep.size() == independent.size());
+    for (size_t i = 0; i < lockstep.size(); i++) {
+        REQUIRE(lockstep[i].point.l1_cache_size == independent[i].point.l1_cache_size);
+        REQUIRE(lockstep[i].error == independent[i].error);
+        REQUIRE(lockstep[i].stats.l1_hits == independent[i].stats.l1_hits);
+        REQUIRE(lockstep[i].stats.l3_misses == independent[i].stats.l3_misses);
+        REQUIRE(lockstep[i].stats.memory_accesses == independent[i].stats.memory_accesses);
+        REQUIRE(lockstep[i].stats.core_cycles == independent[i].stats.core_cycles);
+    }
+}
@@ -0,0 +1,49 @@
+#include "../catch2/catch.hpp"
+#include "../src/cache/victim_cache.h"
+#include "../src/exception/cache_exception.h"
+
+TEST_CASE("Victim Cache - Insert and Extract", "[victim_cache]") {
+    VictimCache victim_cache(2);
+    CacheLine line(7);
+    line.m_data[3] = 42;
+    line.m_dirty = true;
+
+    REQUIRE_FALSE(victim_cache.insert(0x1000, line).has_value());
+    REQUIRE(victim_cache.contains(0x1000));
+    REQUIRE(victim_cache.getSize() == 1);
+
+    CacheLine extracted;
+    REQUIRE(victim_cache.extract(0x1000, extracted));
+    REQUIRE(extracted.m_data[3] == 42);
+    REQUIRE(extracted.m_dirty);
+    REQUIRE_FALSE(victim_cache.contains(0x1000));
+    REQUIRE_FALSE(victim_cache.extract(0x1000, extracted));
+}
+
+TEST_CASE("Victim Cache - Displaces Oldest Entry When Full", "[victim_cache]") {
+    VictimCache victim_cache(2);
+    CacheLine line(1);
+
+    victim_cache.insert(0x1000, line);
+    victim_cache.insert(0x2000, line);
+    std::optional<VictimEntry> displaced = victim_cache.insert(0x3000, line);
+
+    REQUIRE(displaced.has_value());
+    REQUIRE(displaced->m_block_address == 0x1000);
+    REQUIRE(victim_cache.getSize() == 2);
+    REQUIRE(victim_cache.contains(0x2000));
+    REQUIRE(victim_cache.contains(0x3000));
+}
+
+TEST_CASE("Victim Cache - Reinserting Same Block Does Not Duplicate", "[victim_cache]") {
+    VictimCache victim_cache(2);
+    CacheLine line(1);
+
+    victim_cache.insert(0x1000, line);
+    REQUIRE_FALSE(victim_cache.insert(0x1000, line).has_value());
+    REQUIRE(victim_cache.getSize() == 1);
+}
+
+TEST_CASE("Victim Cache - Zero Entries Should Fail", "[victim_cache]") {
+    REQUIRE_THROWS_AS(VictimCache(0), CacheException);
+}
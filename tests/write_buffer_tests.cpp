@@ -0,0 +1,38 @@
+#include "../catch2/catch.hpp"
+#include "../src/cache/write_buffer.h"
+#include "../src/exception/cache_exception.h"
+
+TEST_CASE("Write Buffer - Stores To A Block Coalesce", "[write_buffer]") {
+    WriteBuffer buffer(2);
+    REQUIRE_FALSE(buffer.coalesce(0x1004, 1));
+    buffer.insert(0x1004, 1);
+    REQUIRE(buffer.coalesce(0x1008, 2));
+    REQUIRE(buffer.coalesce(0x1004, 3)); // last value wins
+    REQUIRE(buffer.getSize() == 1);
+
+    std::optional<WriteBufferEntry> entry = buffer.popOldest();
+    REQUIRE(entry.has_value());
+    REQUIRE(entry->m_block_address == 0x1000);
+    REQUIRE(entry->m_word_mask == 0b110);
+    REQUIRE(entry->m_data[1] == 3);
+    REQUIRE(entry->m_data[2] == 2);
+    REQUIRE(buffer.isEmpty());
+}
+
+TEST_CASE("Write Buffer - Drains Oldest First", "[write_buffer]") {
+    WriteBuffer buffer(2);
+    buffer.insert(0x2000, 1);
+    buffer.insert(0x1000, 2);
+    REQUIRE(buffer.isFull());
+    REQUIRE_THROWS_AS(buffer.insert(0x3000, 3), CacheException);
+
+    WriteBufferEntry extracted;
+    REQUIRE(buffer.extract(0x1000, extracted));
+    REQUIRE_FALSE(buffer.contains(0x1000));
+    REQUIRE(buffer.popOldest()->m_block_address == 0x2000);
+    REQUIRE_FALSE(buffer.popOldest().has_value());
+}
+
+TEST_CASE("Write Buffer - Invalid Size Should Fail", "[write_buffer]") {
+    REQUIRE_THROWS_AS(WriteBuffer(0), CacheException);
+}